@@ -293,6 +293,21 @@ public:
     //  true if it has succeeded, false if it has failed
     static bool VirtualReset(void *address, size_t size, bool unlock);
 
+    // Get the size of a transparent huge page.
+    // Return:
+    //  Size of a transparent huge page, or 0 if the OS does not support transparent huge pages
+    //  or they are disabled.
+    static size_t GetTransparentHugePageSize();
+
+    // Advise the OS whether a virtual memory range should be backed by transparent huge pages.
+    // Parameters:
+    //  address   - starting virtual address
+    //  size      - size of the virtual memory range
+    //  hugePages - true to ask for huge pages, false to ask for the range to never use them
+    // Return:
+    //  true if it has succeeded, false if it has failed
+    static bool VirtualAdviseHugePages(void *address, size_t size, bool hugePages);
+
     //
     // Write watching
     //
@@ -42,7 +42,7 @@
 #endif // defined(FEATURE_SVR_GC)
 #endif // __INTELLISENSE__
 
-#ifdef TARGET_AMD64
+#if defined(TARGET_AMD64) || defined(TARGET_ARM64)
 #include "vxsort/do_vxsort.h"
 #endif
 
@@ -55,7 +55,7 @@ namespace WKS {
 #include "gcimpl.h"
 #include "gcpriv.h"
 
-#ifdef TARGET_AMD64
+#if defined(TARGET_AMD64) || defined(TARGET_ARM64)
 #define USE_VXSORT
 #else
 #define USE_INTROSORT
@@ -192,7 +192,10 @@ const char * const msl_take_state_str[] = {
     "alloc_small_cant",
     "alloc_large_cant",
     "try_alloc",
-    "try_budget"
+    "try_budget",
+    "try_servo_budget",
+    "decommit_step",
+    "commit_ahead"
 };
 #endif //TRACE_GC
 
@@ -666,7 +669,10 @@ enum gc_join_stage
     // No longer in use but do not remove, see comments for this enum.
     gc_join_disable_software_write_watch = 38,
     gc_join_merge_temp_fl = 39,
-    gc_join_max = 40
+    gc_join_sweep_in_plan = 40,
+    gc_join_sweep_in_plan_done = 41,
+    gc_join_concurrent_revisit = 42,
+    gc_join_max = 43
 };
 
 enum gc_join_flavor
@@ -2311,6 +2317,13 @@ VOLATILE(BOOL) gc_heap::gc_started;
 #ifdef MULTIPLE_HEAPS
 GCEvent     gc_heap::gc_start_event;
 bool        gc_heap::gc_thread_no_affinitize_p = false;
+bool        gc_heap::enable_mark_steal_p = false;
+bool        gc_heap::enable_bgc_parallel_revisit_p = false;
+#ifdef USE_REGIONS
+bool        gc_heap::enable_parallel_sweep_in_plan_p = true;
+size_t      gc_heap::commit_ahead_max_regions = 0;
+bool        gc_heap::clear_ahead_p = false;
+#endif //USE_REGIONS
 uintptr_t   process_mask = 0;
 
 int         gc_heap::n_heaps;       // current number of heaps
@@ -2326,11 +2339,22 @@ size_t*     gc_heap::g_promoted;
 int*        gc_heap::g_mark_stack_busy;
 #endif //MH_SC_MARK
 
+bool        gc_heap::mark_steal_p;
+
+VOLATILE(int32_t) gc_heap::mark_steal_active_count;
+
+#ifdef USE_REGIONS
+bool        gc_heap::sip_sweep_steal_p = false;
+#endif //USE_REGIONS
+
 #ifdef BACKGROUND_GC
 size_t*     gc_heap::g_bpromoted;
 #endif //BACKGROUND_GC
 
 BOOL        gc_heap::gradual_decommit_in_progress_p = FALSE;
+#ifdef USE_REGIONS
+BOOL        gc_heap::commit_ahead_in_progress_p = FALSE;
+#endif //USE_REGIONS
 size_t      gc_heap::max_decommit_step_size = 0;
 #else  //MULTIPLE_HEAPS
 
@@ -2508,6 +2532,10 @@ GCEvent     gc_heap::ee_proceed_event;
 
 bool        gc_heap::gc_can_use_concurrent = false;
 
+#ifdef USE_REGIONS
+bool        gc_heap::enable_bgc_uoh_sweep_per_region_p = false;
+#endif //USE_REGIONS
+
 bool        gc_heap::temp_disable_concurrent_p = false;
 
 uint32_t    gc_heap::cm_in_progress = FALSE;
@@ -2876,6 +2904,8 @@ size_t        gc_heap::last_gc_end_time_us = 0;
 #endif //HEAP_BALANCE_INSTRUMENTATION
 #ifdef USE_REGIONS
 bool          gc_heap::enable_special_regions_p = false;
+int           gc_heap::gen2_compact_region_budget = 0;
+size_t        gc_heap::region_huge_page_size = 0;
 #else //USE_REGIONS
 size_t        gc_heap::min_segment_size = 0;
 size_t        gc_heap::min_uoh_segment_size = 0;
@@ -7099,6 +7129,9 @@ void gc_heap::gc_thread_function ()
         if (heap_number == 0)
         {
             bool wait_on_time_out_p = gradual_decommit_in_progress_p;
+#ifdef USE_REGIONS
+            wait_on_time_out_p = wait_on_time_out_p || commit_ahead_in_progress_p;
+#endif //USE_REGIONS
             uint32_t wait_time = DECOMMIT_TIME_STEP_MILLISECONDS;
 #ifdef DYNAMIC_HEAP_COUNT
             // background_running_p can only change from false to true during suspension.
@@ -7150,6 +7183,14 @@ void gc_heap::gc_thread_function ()
                     decommit_lock.Leave ();
 #endif //COMMITTED_BYTES_SHADOW
                 }
+#ifdef USE_REGIONS
+                // only commit ahead once we are done decommitting, otherwise we'd be
+                // committing memory we just decided we have too much of
+                else if (commit_ahead_in_progress_p)
+                {
+                    commit_ahead_in_progress_p = commit_ahead_step();
+                }
+#endif //USE_REGIONS
                 continue;
             }
 
@@ -7370,6 +7411,12 @@ void gc_heap::gc_thread_function ()
                 decommit_lock.Leave ();
 #endif //COMMITTED_BYTES_SHADOW
             }
+#ifdef USE_REGIONS
+            else if (commit_ahead_in_progress_p)
+            {
+                commit_ahead_in_progress_p = commit_ahead_step();
+            }
+#endif //USE_REGIONS
         }
         else
         {
@@ -7390,12 +7437,26 @@ void gc_heap::gc_thread_function ()
 
 #endif //MULTIPLE_HEAPS
 
+#if defined(USE_REGIONS) && defined(MULTIPLE_HEAPS)
+// Regions move between heaps that can be on different nodes, so we commit a region's memory
+// on the node the region was created on instead of the node of the heap committing it.
+inline
+uint16_t gc_heap::numa_node_of_heap_memory (void* addr)
+{
+    return heap_segment_numa_node (get_region_info_for_address ((uint8_t*)addr));
+}
+#endif //USE_REGIONS && MULTIPLE_HEAPS
+
 bool gc_heap::virtual_alloc_commit_for_heap (void* addr, size_t size, int h_number)
 {
 #ifdef MULTIPLE_HEAPS
     if (GCToOSInterface::CanEnableGCNumaAware())
     {
+#ifdef USE_REGIONS
+        uint16_t numa_node = numa_node_of_heap_memory (addr);
+#else
         uint16_t numa_node = heap_select::find_numa_node_from_heap_no(h_number);
+#endif //USE_REGIONS
         if (GCToOSInterface::VirtualCommit (addr, size, numa_node))
             return true;
     }
@@ -8505,6 +8566,9 @@ void gc_heap::make_mark_stack (mark* arr)
 #ifdef MH_SC_MARK
     mark_stack_busy() = 0;
 #endif //MH_SC_MARK
+#ifdef MULTIPLE_HEAPS
+    mark_deque.init();
+#endif //MULTIPLE_HEAPS
 }
 
 #ifdef BACKGROUND_GC
@@ -10481,8 +10545,23 @@ private:
 #endif //defined(USE_INTROSORT) || defined(USE_VXSORT)
 
 #ifdef USE_VXSORT
+// whether the mark list can be sorted with vectorized code, which lets us use bigger mark lists
+static bool is_vxsort_supported()
+{
+#ifdef TARGET_ARM64
+    return IsSupportedInstructionSet (InstructionSet::NEON);
+#else //TARGET_ARM64
+    return IsSupportedInstructionSet (InstructionSet::AVX2);
+#endif //TARGET_ARM64
+}
+
 static void do_vxsort (uint8_t** item_array, ptrdiff_t item_count, uint8_t* range_low, uint8_t* range_high)
 {
+#ifdef TARGET_ARM64
+    // above this threshold, using NEON for sorting will likely pay off - there is
+    // no downclocking to amortize, but NEON only holds 2 pointers per vector
+    const ptrdiff_t NEON_THRESHOLD_SIZE = 8 * 1024;
+#else //TARGET_ARM64
     // above this threshold, using AVX2 for sorting will likely pay off
     // despite possible downclocking on some devices
     const ptrdiff_t AVX2_THRESHOLD_SIZE = 8 * 1024;
@@ -10490,10 +10569,19 @@ static void do_vxsort (uint8_t** item_array, ptrdiff_t item_count, uint8_t* rang
     // above this threshold, using AVX512F for sorting will likely pay off
     // despite possible downclocking on current devices
     const ptrdiff_t AVX512F_THRESHOLD_SIZE = 128 * 1024;
+#endif //TARGET_ARM64
 
     if (item_count <= 1)
         return;
 
+#ifdef TARGET_ARM64
+    if (IsSupportedInstructionSet (InstructionSet::NEON) && (item_count > NEON_THRESHOLD_SIZE))
+    {
+        dprintf(3, ("Sorting mark lists"));
+
+        do_vxsort_neon (item_array, &item_array[item_count - 1], range_low, range_high);
+    }
+#else //TARGET_ARM64
     if (IsSupportedInstructionSet (InstructionSet::AVX2) && (item_count > AVX2_THRESHOLD_SIZE))
     {
         dprintf(3, ("Sorting mark lists"));
@@ -10508,6 +10596,7 @@ static void do_vxsort (uint8_t** item_array, ptrdiff_t item_count, uint8_t* rang
             do_vxsort_avx2 (item_array, &item_array[item_count - 1], range_low, range_high);
         }
     }
+#endif //TARGET_ARM64
     else
     {
         dprintf (3, ("Sorting mark lists"));
@@ -10524,8 +10613,66 @@ static void do_vxsort (uint8_t** item_array, ptrdiff_t item_count, uint8_t* rang
     assert ((range_low <= item_array[0]) && (item_array[item_count - 1] <= range_high));
 #endif
 }
+
+// Set at init from the instruction sets we are allowed to use - the card scanning below is too hot to
+// call IsSupportedInstructionSet every time.
+static bool vectorized_card_scan_avx2_p = false;
+static bool vectorized_card_scan_avx512_p = false;
+static bool vectorized_card_scan_neon_p = false;
+
+static void init_vectorized_card_scan()
+{
+#ifdef TARGET_ARM64
+    vectorized_card_scan_neon_p = IsSupportedInstructionSet (InstructionSet::NEON);
+#else //TARGET_ARM64
+    vectorized_card_scan_avx2_p = IsSupportedInstructionSet (InstructionSet::AVX2);
+    vectorized_card_scan_avx512_p = IsSupportedInstructionSet (InstructionSet::AVX512F);
+#endif //TARGET_ARM64
+}
+#endif //USE_VXSORT
+
+// Returns the first non-zero word in [word, word_end), or word_end if they are all zero.
+// When cross generation pointers are sparse most of the time finding cards is spent skipping
+// zero card words and card bundle words, so longer runs use the vectorized scan if we have one.
+static uint32_t* find_nonzero_word (uint32_t* word, uint32_t* word_end)
+{
+#ifdef USE_VXSORT
+    // below this the scalar loop is about as fast as the call
+    const ptrdiff_t VECTORIZED_SCAN_THRESHOLD_SIZE = 16;
+#ifndef TARGET_ARM64
+    // only use AVX512F for runs long enough to pay for possible downclocking
+    const ptrdiff_t AVX512F_SCAN_THRESHOLD_SIZE = 1024;
+#endif //!TARGET_ARM64
+
+    ptrdiff_t word_count = word_end - word;
+    if (word_count >= VECTORIZED_SCAN_THRESHOLD_SIZE)
+    {
+#ifdef TARGET_ARM64
+        if (vectorized_card_scan_neon_p)
+        {
+            return find_nonzero_word_neon (word, word_end);
+        }
+#else //TARGET_ARM64
+        if (vectorized_card_scan_avx512_p && (word_count >= AVX512F_SCAN_THRESHOLD_SIZE))
+        {
+            return find_nonzero_word_avx512 (word, word_end);
+        }
+        if (vectorized_card_scan_avx2_p)
+        {
+            return find_nonzero_word_avx2 (word, word_end);
+        }
+#endif //TARGET_ARM64
+    }
 #endif //USE_VXSORT
 
+    while ((word < word_end) && !(*word))
+    {
+        word++;
+    }
+
+    return word;
+}
+
 #ifdef MULTIPLE_HEAPS
 static size_t target_mark_count_for_heap (size_t total_mark_count, int heap_count, int heap_number)
 {
@@ -11142,10 +11289,10 @@ void gc_heap::grow_mark_list ()
     // with vectorized sorting, we can use bigger mark lists
 #ifdef USE_VXSORT
 #ifdef MULTIPLE_HEAPS
-    const size_t MAX_MARK_LIST_SIZE = IsSupportedInstructionSet (InstructionSet::AVX2) ?
+    const size_t MAX_MARK_LIST_SIZE = is_vxsort_supported() ?
         (1000 * 1024) : (200 * 1024);
 #else //MULTIPLE_HEAPS
-    const size_t MAX_MARK_LIST_SIZE = IsSupportedInstructionSet (InstructionSet::AVX2) ?
+    const size_t MAX_MARK_LIST_SIZE = is_vxsort_supported() ?
         (32 * 1024) : (16 * 1024);
 #endif //MULTIPLE_HEAPS
 #else //USE_VXSORT
@@ -12396,6 +12543,11 @@ heap_segment* gc_heap::make_heap_segment (uint8_t* new_pages, size_t size, gc_he
         0;
 #endif //MULTIPLE_HEAPS
 
+#if defined(USE_REGIONS) && defined(MULTIPLE_HEAPS)
+    // This needs to be set before we commit anything for the region, see numa_node_of_heap_memory.
+    heap_segment_numa_node (get_region_info (new_pages)) = heap_select::find_numa_node_from_heap_no (h_number);
+#endif //USE_REGIONS && MULTIPLE_HEAPS
+
     if (!virtual_commit (new_pages, initial_commit, oh, h_number))
     {
         return 0;
@@ -12420,6 +12572,9 @@ heap_segment* gc_heap::make_heap_segment (uint8_t* new_pages, size_t size, gc_he
                        , new_pages, size, gen_num
 #endif //USE_REGIONS
                        );
+#ifdef USE_REGIONS
+    advise_region_huge_pages (new_segment, new_pages, initial_commit);
+#endif //USE_REGIONS
     dprintf (2, ("Creating heap segment %zx", (size_t)new_segment));
 
     return new_segment;
@@ -12548,6 +12703,38 @@ void gc_heap::delete_heap_segment (heap_segment* seg, BOOL consider_hoarding)
 #endif //USE_REGIONS
 }
 
+#ifdef USE_REGIONS
+// gen2 and UOH regions stay around and are what mark and relocate keep walking through,
+// so when GCRegionHugePages is on we ask the OS to back them with transparent huge pages
+// to cut down on TLB misses. gen0 regions are short lived and get decommitted all the
+// time so the whole regions range is advised to never use huge pages when we reserve it.
+//
+// The advice is given once for each range we commit for a gen2 or UOH region, never when
+// a region is reused or promoted, as those happen on the allocation path and in plan.
+// This means a region promoted into gen2 in place only gets huge pages for what it commits
+// from then on, and a free region reused for gen0 keeps huge pages for the part it already
+// had committed until that's decommitted.
+inline
+bool gc_heap::region_huge_pages_p (heap_segment* region)
+{
+    return ((region_huge_page_size != 0) && (heap_segment_gen_num (region) >= max_generation));
+}
+
+void gc_heap::advise_region_huge_pages (heap_segment* region, uint8_t* start, size_t size)
+{
+    if (!region_huge_pages_p (region))
+    {
+        return;
+    }
+
+    if (!GCToOSInterface::VirtualAdviseHugePages (start, size, true))
+    {
+        dprintf (REGIONS_LOG, ("failed to advise region %p [%p, %p[ huge pages",
+            heap_segment_mem (region), start, (start + size)));
+    }
+}
+#endif //USE_REGIONS
+
 //resets the pages beyond allocates size so they won't be swapped out and back in
 
 void gc_heap::reset_heap_segment_pages (heap_segment* seg)
@@ -12581,6 +12768,15 @@ size_t gc_heap::decommit_heap_segment_pages_worker (heap_segment* seg,
 {
     assert (!use_large_pages_p);
     uint8_t* page_start = align_on_page (new_committed);
+#ifdef USE_REGIONS
+    if (region_huge_pages_p (seg))
+    {
+        // Only give back whole huge pages, otherwise the OS has to split the huge page that
+        // page_start falls into.
+        uint8_t* huge_page_start = (uint8_t*)(((size_t)page_start + region_huge_page_size - 1) & ~(region_huge_page_size - 1));
+        page_start = min (huge_page_start, heap_segment_committed (seg));
+    }
+#endif //USE_REGIONS
     ptrdiff_t size = heap_segment_committed (seg) - page_start;
     if (size > 0)
     {
@@ -12841,6 +13037,29 @@ static int64_t add_regions (region_free_list* free_list, region_free_list* surpl
     return added_count;
 }
 
+#ifdef MULTIPLE_HEAPS
+// add regions created on numa_node from surplus_list to free_list, trying to reach target_count
+static int64_t add_regions_on_node (region_free_list* free_list, region_free_list* surplus_list, size_t target_count, uint16_t numa_node)
+{
+    int64_t added_count = 0;
+    heap_segment* next_region = nullptr;
+    for (heap_segment* region = surplus_list->get_first_free_region();
+         (region != nullptr) && (free_list->get_num_free_regions() < target_count);
+         region = next_region)
+    {
+        next_region = heap_segment_next (region);
+        if (heap_segment_numa_node (region) == numa_node)
+        {
+            added_count++;
+
+            region_free_list::unlink_region (region);
+            free_list->add_region_front (region);
+        }
+    }
+    return added_count;
+}
+#endif //MULTIPLE_HEAPS
+
 region_free_list::region_free_list() : num_free_regions (0),
                                        size_free_regions (0),
                                        size_committed_in_free_regions (0),
@@ -13676,6 +13895,29 @@ void gc_heap::distribute_free_regions()
                 remove_surplus_regions (&hp->free_regions[kind], &surplus_regions[kind], heap_budget_in_region_units[i][kind]);
             }
         }
+        // if the heaps are on more than one NUMA node, first give heaps having too few free regions
+        // the surplus regions from their own node so they don't end up allocating in remote memory
+        if (heap_select::find_numa_node_from_heap_no (0) != heap_select::find_numa_node_from_heap_no (n_heaps - 1))
+        {
+            for (int i = 0; i < n_heaps; i++)
+            {
+                gc_heap* hp = g_heaps[i];
+                if (hp->free_regions[kind].get_num_free_regions() < heap_budget_in_region_units[i][kind])
+                {
+                    uint16_t numa_node = heap_select::find_numa_node_from_heap_no (i);
+                    int64_t num_added_regions = add_regions_on_node (&hp->free_regions[kind], &surplus_regions[kind],
+                                                                     heap_budget_in_region_units[i][kind], numa_node);
+                    dprintf (REGIONS_LOG, ("added %zd %s regions from node %d to heap %d - now has %zd, budget is %zd",
+                        (size_t)num_added_regions,
+                        kind_name[kind],
+                        (int)numa_node,
+                        i,
+                        hp->free_regions[kind].get_num_free_regions(),
+                        heap_budget_in_region_units[i][kind]));
+                }
+            }
+        }
+
         // finally go through all the heaps and distribute any surplus regions to heaps having too few free regions
         for (int i = 0; i < n_heaps; i++)
         {
@@ -13716,6 +13958,9 @@ void gc_heap::distribute_free_regions()
             break;
         }
     }
+
+    // under a hard limit we don't want to commit memory the application may never use
+    commit_ahead_in_progress_p = ((commit_ahead_max_regions != 0) && (heap_hard_limit == 0));
 #else //MULTIPLE_HEAPS
     // we want to limit the amount of decommit we do per time to indirectly
     // limit the amount of time spent in recommit and page faults
@@ -14293,6 +14538,10 @@ HRESULT gc_heap::initialize_gc (size_t soh_segment_size,
     }
 
     GCConfig::SetConcurrentGC(gc_can_use_concurrent);
+
+#ifdef USE_REGIONS
+    enable_bgc_uoh_sweep_per_region_p = GCConfig::GetGCBGCUOHSweepPerRegion();
+#endif //USE_REGIONS
 #else //BACKGROUND_GC
     GCConfig::SetConcurrentGC(false);
 #endif //BACKGROUND_GC
@@ -14340,6 +14589,12 @@ HRESULT gc_heap::initialize_gc (size_t soh_segment_size,
         if (!reserve_range)
             return E_OUTOFMEMORY;
 
+        if (region_huge_page_size != 0)
+        {
+            // gen2 and UOH regions ask for huge pages as they commit, see advise_region_huge_pages.
+            GCToOSInterface::VirtualAdviseHugePages (reserve_range, reserve_size, false);
+        }
+
         if (!global_region_allocator.init (reserve_range, (reserve_range + reserve_size),
                                            ((size_t)1 << min_segment_size_shr),
                                            &g_gc_lowest_address, &g_gc_highest_address))
@@ -14487,6 +14742,7 @@ HRESULT gc_heap::initialize_gc (size_t soh_segment_size,
 
 #ifdef USE_VXSORT
     InitSupportedInstructionSet ((int32_t)GCConfig::GetGCEnabledInstructionSets());
+    init_vectorized_card_scan();
 #endif
 
     if (!init_semi_shared())
@@ -14559,6 +14815,12 @@ gc_heap::init_semi_shared()
 
     // but do at least MIN_DECOMMIT_SIZE per step to make the OS call worthwhile
     max_decommit_step_size = max (max_decommit_step_size, MIN_DECOMMIT_SIZE);
+
+#ifdef USE_REGIONS
+    // with large pages everything is already committed so there's nothing to commit ahead
+    commit_ahead_max_regions = use_large_pages_p ? 0 : (size_t)GCConfig::GetGCCommitAheadRegions();
+    clear_ahead_p = (commit_ahead_max_regions != 0) && GCConfig::GetGCClearAheadRegions();
+#endif //USE_REGIONS
 #endif //MULTIPLE_HEAPS
 
 #ifdef FEATURE_BASICFREEZE
@@ -15257,6 +15519,9 @@ gc_heap::init_gc_heap (int h_number)
 
     fgn_maxgen_percent = 0;
     fgn_last_alloc = dd_min_size (dynamic_data_of (0));
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    commit_ahead_region = nullptr;
+#endif //MULTIPLE_HEAPS && USE_REGIONS
 
     mark* arr = new (nothrow) (mark [MARK_STACK_INITIAL_LENGTH]);
     if (!arr)
@@ -15576,6 +15841,9 @@ BOOL gc_heap::grow_heap_segment (heap_segment* seg, uint8_t* high_address, bool*
     bool ret = virtual_commit (heap_segment_committed (seg), c_size, heap_segment_oh (seg), heap_number, hard_limit_exceeded_p);
     if (ret)
     {
+#ifdef USE_REGIONS
+        advise_region_huge_pages (seg, heap_segment_committed (seg), c_size);
+#endif //USE_REGIONS
         heap_segment_committed (seg) += c_size;
 
         STRESS_LOG1(LF_GC, LL_INFO10000, "New commit: %zx\n",
@@ -18362,6 +18630,33 @@ void gc_heap::bgc_untrack_uoh_alloc()
     }
 }
 
+#ifdef USE_REGIONS
+// Called by the BGC thread in between the UOH regions it sweeps. UOH allocations can be
+// satisfied from the free list, which only has free space from the regions swept so far,
+// or at the end of a region. We are in c_gc_state_planning so whatever gets allocated is
+// marked and will be kept by the sweep of the regions that are left. Regions added now
+// have a 0 background_allocated so the sweep skips them.
+void gc_heap::bgc_uoh_sweep_allow_alloc()
+{
+    add_saved_spinlock_info (true, me_release, mt_bgc_uoh_sweep, msl_entered);
+    leave_spin_lock (&more_space_lock_uoh);
+
+    // give the allocating threads spinning on the msl a chance to take it
+    GCToOSInterface::YieldThread (0);
+
+    enter_spin_lock (&more_space_lock_uoh);
+    add_saved_spinlock_info (true, me_acquire, mt_bgc_uoh_sweep, msl_entered);
+
+    // Same as when we first took the msl for the UOH sweep, the objects allocated while we
+    // weren't holding it need to be published before we can walk over them.
+    int spin_count = yp_spin_count_unit;
+    while (uoh_alloc_thread_count)
+    {
+        spin_and_switch (spin_count, (uoh_alloc_thread_count == 0));
+    }
+}
+#endif //USE_REGIONS
+
 // We need to throttle the UOH allocations during BGC since we can't
 // collect UOH when BGC is in progress (when BGC sweeps UOH allocations on UOH are disallowed)
 // We allow the UOH heap size to double during a BGC. And for every
@@ -24114,6 +24409,10 @@ void gc_heap::init_records()
     gen0_pinned_free_space = 0;
     gen0_large_chunk_found = false;
     num_regions_freed_in_sweep = 0;
+#ifdef MULTIPLE_HEAPS
+    num_sip_regions_deferred = 0;
+    sip_sweep_claimed_count = 0;
+#endif //MULTIPLE_HEAPS
 #endif //USE_REGIONS
 
     sufficient_gen0_space_p = FALSE;
@@ -24181,6 +24480,10 @@ void gc_heap::garbage_collect (int n)
 
     fix_allocation_contexts (TRUE);
 #ifdef MULTIPLE_HEAPS
+#ifdef USE_REGIONS
+    // the GC owns the free lists, so this doesn't need the more space lock
+    return_commit_ahead_region();
+#endif //USE_REGIONS
 #ifdef JOIN_STATS
     gc_t_join.start_ts(this);
 #endif //JOIN_STATS
@@ -25904,6 +26207,52 @@ void gc_heap::calculate_new_heap_count ()
                 mb (total_soh_stable_size), mb (total_bcd), diff_pct, change_int, (change_int * 100.0 / n_heaps)));
         }
 
+        if (dynamic_heap_count_data.pause_target_p())
+        {
+            // tcp only tells us about the total cost - with a pause target we also need to make sure the individual
+            // pauses are not too long. We don't let tcp take us below the HC needed to meet the target and if the
+            // pauses are already too long, we grow even if tcp says we don't need to.
+            uint64_t pause_at_percentile = dynamic_heap_count_data.get_pause_percentile();
+            if (pause_at_percentile)
+            {
+                int hc_for_pause = dynamic_heap_count_data.get_hc_for_pause_target (pause_at_percentile, n_heaps);
+                int pause_n_heaps = new_n_heaps;
+
+                if ((hc_for_pause > n_heaps) && (new_n_heaps < hc_for_pause))
+                {
+                    int max_growth = dynamic_heap_count_data.get_max_growth (n_heaps);
+                    pause_n_heaps = min (hc_for_pause, min ((n_heaps + max_growth), actual_n_max_heaps));
+                    pause_n_heaps = max (pause_n_heaps, new_n_heaps);
+                }
+                else if ((new_n_heaps < n_heaps) && (new_n_heaps < hc_for_pause))
+                {
+                    pause_n_heaps = min (hc_for_pause, n_heaps);
+                }
+
+                if (pause_n_heaps != new_n_heaps)
+                {
+                    dprintf (6666, ("[CHP-PT] p%d pause %I64dus, target %I64dus needs %d heaps, HC %d -> %d instead of %d",
+                        dynamic_heap_count_data_t::pause_percentile, pause_at_percentile, dynamic_heap_count_data.target_pause_us,
+                        hc_for_pause, n_heaps, pause_n_heaps, new_n_heaps));
+
+                    new_n_heaps = pause_n_heaps;
+                    adj_metric = dynamic_heap_count_data_t::adjust_metric::adjust_hc;
+
+                    // If tcp already decided to change HC in this GC, we just update that adjustment.
+                    dynamic_heap_count_data_t::adjustment* last_adj = dynamic_heap_count_data.get_last_adjustment();
+                    if ((last_adj->gc_index == current_gc_index) && (last_adj->metric == adj_metric))
+                    {
+                        last_adj->hc_change = new_n_heaps - n_heaps;
+                    }
+                    else
+                    {
+                        dynamic_heap_count_data.record_adjustment (adj_metric, (median_throughput_cost_percent - target_tcp),
+                                                                   (new_n_heaps - n_heaps), current_gc_index);
+                    }
+                }
+            }
+        }
+
         GCEventFireSizeAdaptationTuning_V1 (
             (uint16_t)new_n_heaps,
             (uint16_t)max_heap_count_datas,
@@ -26613,6 +26962,9 @@ bool gc_heap::change_heap_count (int new_n_heaps)
         total_change_heap_count_time += change_heap_count_time;
         total_change_heap_count++;
         dprintf (6666, ("changing HC took %I64dus", change_heap_count_time));
+
+        // The pauses we recorded were with the old HC so they don't tell us anything about the new one.
+        dynamic_heap_count_data.init_recorded_pause();
     }
 
     return true;
@@ -26637,6 +26989,38 @@ void gc_heap::get_msl_wait_time (size_t* soh_msl_wait_time, size_t* uoh_msl_wait
     }
 }
 
+// If we are already at the max HC we can't make the pauses shorter by adding heaps so we make the gen0 budget
+// smaller instead - less gets allocated between GCs so less survives each gen0/gen1 GC.
+size_t gc_heap::adjust_gen0_budget_for_pause_target (size_t budget_per_heap)
+{
+    assert (dynamic_heap_count_data.pause_target_p());
+
+    int extra_heaps = (n_max_heaps >= 16) + (n_max_heaps >= 64);
+    int actual_n_max_heaps = n_max_heaps - extra_heaps;
+    if (n_heaps < actual_n_max_heaps)
+    {
+        return budget_per_heap;
+    }
+
+    uint64_t pause_at_percentile = dynamic_heap_count_data.get_pause_percentile();
+    uint64_t target_pause_us = dynamic_heap_count_data.target_pause_us;
+    if (pause_at_percentile <= target_pause_us)
+    {
+        return budget_per_heap;
+    }
+
+    size_t new_budget_per_heap = (size_t)((double)budget_per_heap * target_pause_us / pause_at_percentile);
+    new_budget_per_heap = Align (new_budget_per_heap, get_alignment_constant (TRUE));
+    new_budget_per_heap = max (new_budget_per_heap, dynamic_heap_count_data.min_gen0_new_allocation);
+    new_budget_per_heap = min (new_budget_per_heap, budget_per_heap);
+
+    dprintf (6666, ("at max HC %d, p%d pause %I64dus > target %I64dus, budget %Id -> %Id",
+        n_heaps, dynamic_heap_count_data_t::pause_percentile, pause_at_percentile, target_pause_us,
+        budget_per_heap, new_budget_per_heap));
+
+    return new_budget_per_heap;
+}
+
 void gc_heap::process_datas_sample()
 {
     // We get the time here instead of waiting till we assign end_gc_time because end_gc_time includes distribute_free_regions
@@ -26666,6 +27050,12 @@ void gc_heap::process_datas_sample()
             (((float)sample.msl_wait_time / n_heaps + sample.gc_pause_time) * 100.0f / (float)sample.elapsed_between_gcs) : 0.0f);
         size_t total_soh_stable_size = get_total_soh_stable_size();
         desired_per_heap_datas = dynamic_heap_count_data.compute_gen0_budget_per_heap (total_soh_stable_size, tcp, desired_per_heap);
+
+        if (dynamic_heap_count_data.pause_target_p() && (settings.condemned_generation < max_generation))
+        {
+            dynamic_heap_count_data.add_to_recorded_pause (gc_pause_time);
+            desired_per_heap_datas = adjust_gen0_budget_for_pause_target (desired_per_heap_datas);
+        }
         dprintf (6666, ("gen0 new_alloc %Id (%.3fmb), from datas: %Id (%.3fmb)",
             desired_per_heap, mb (desired_per_heap), desired_per_heap_datas, mb (desired_per_heap_datas)));
         dprintf (6666, ("budget DATAS %Id, previous %Id", desired_per_heap_datas, desired_per_heap));
@@ -27557,6 +27947,95 @@ void mark_queue_t::verify_empty()
 #endif //MARK_PHASE_PREFETCH
 }
 
+#ifdef MULTIPLE_HEAPS
+// How many fanned out objects a heap marks before it re-checks whether other heaps
+// are idle, see mark_steal_offer_p.
+const int mark_steal_check_interval = 64;
+
+void mark_steal_deque::init()
+{
+    top = 0;
+    bottom = 0;
+}
+
+// only called by the owning heap
+bool mark_steal_deque::push (uint8_t* o)
+{
+    size_t b = bottom;
+    size_t t = VolatileLoad (&top);
+    if ((b - t) >= slot_count)
+    {
+        return false;
+    }
+    slot_table[b & slot_mask] = o;
+    // the slot must be visible before thieves can see the new bottom
+    VolatileStore (&bottom, b + 1);
+    return true;
+}
+
+// only called by the owning heap
+uint8_t* mark_steal_deque::pop()
+{
+    size_t b = bottom;
+    if (b == VolatileLoad (&top))
+    {
+        return nullptr;
+    }
+    b--;
+    VolatileStore (&bottom, b);
+    // the new bottom needs to be visible to thieves before we read top
+    MemoryBarrier();
+    size_t t = VolatileLoad (&top);
+    if (t > b)
+    {
+        // a thief took the last entry
+        VolatileStore (&bottom, t);
+        return nullptr;
+    }
+    uint8_t* o = slot_table[b & slot_mask];
+    if (t == b)
+    {
+        // racing with thieves for the last entry
+        if (Interlocked::CompareExchange (&top, t + 1, t) != t)
+        {
+            o = nullptr;
+        }
+        VolatileStore (&bottom, t + 1);
+    }
+    return o;
+}
+
+// called by other heaps
+uint8_t* mark_steal_deque::steal()
+{
+    size_t t = VolatileLoad (&top);
+    MemoryBarrier();
+    size_t b = VolatileLoad (&bottom);
+    if (t >= b)
+    {
+        return nullptr;
+    }
+    uint8_t* o = VolatileLoad (&slot_table[t & slot_mask]);
+    if (Interlocked::CompareExchange (&top, t + 1, t) != t)
+    {
+        return nullptr;
+    }
+    return o;
+}
+
+inline
+bool gc_heap::mark_steal_offer_p()
+{
+    if (mark_steal_check_countdown == 0)
+    {
+        mark_steal_offer_cached_p = (mark_steal_active_count < n_heaps);
+        mark_steal_check_countdown = mark_steal_check_interval;
+    }
+    mark_steal_check_countdown--;
+    return mark_steal_offer_cached_p;
+}
+#endif //MULTIPLE_HEAPS
+
 void gc_heap::mark_object_simple1 (uint8_t* oo, uint8_t* start THREAD_NUMBER_DCL)
 {
     SERVER_SC_MARK_VOLATILE(uint8_t*)* mark_stack_tos = (SERVER_SC_MARK_VOLATILE(uint8_t*)*)mark_stack_array;
@@ -27613,6 +28092,9 @@ void gc_heap::mark_object_simple1 (uint8_t* oo, uint8_t* start THREAD_NUMBER_DCL
                 if (overflow_p == FALSE)
                 {
                     dprintf(3,("pushing mark for %zx ", (size_t)oo));
+#ifdef MULTIPLE_HEAPS
+                    SERVER_SC_MARK_VOLATILE(uint8_t*)* children_tos = mark_stack_tos;
+#endif //MULTIPLE_HEAPS
 
                     go_through_object_cl (method_table(oo), oo, s, ppslot,
                                           {
@@ -27635,6 +28117,22 @@ void gc_heap::mark_object_simple1 (uint8_t* oo, uint8_t* start THREAD_NUMBER_DCL
                                               }
                                           }
                         );
+
+#ifdef MULTIPLE_HEAPS
+                    // If some heaps are out of work and this object fanned out, let them have
+                    // the child we'd otherwise get to last. It's a plain object, not a partial
+                    // mark tuple, so whoever steals it can trace it from the start.
+                    // mark_steal_active_count is written by every heap that steals so we only
+                    // look at it every mark_steal_check_interval fanned out objects.
+                    if (mark_steal_p && ((mark_stack_tos - children_tos) >= 2) &&
+                        mark_steal_offer_p())
+                    {
+                        if (mark_deque.push (*(mark_stack_tos - 1)))
+                        {
+                            mark_stack_tos--;
+                        }
+                    }
+#endif //MULTIPLE_HEAPS
                 }
                 else
                 {
@@ -27786,6 +28284,14 @@ more_to_do:
             sorted_tos = min ((size_t)sorted_tos, (size_t)mark_stack_tos);
 #endif //SORT_MARK_STACK
         }
+#ifdef MULTIPLE_HEAPS
+        else if ((oo = mark_deque.pop()) != nullptr)
+        {
+            // take back what nobody stole - we must not return with a non empty deque
+            start = oo;
+            *mark_stack_tos = oo;
+        }
+#endif //MULTIPLE_HEAPS
         else
             break;
     }
@@ -28239,6 +28745,72 @@ void gc_heap::drain_mark_queue ()
     }
 }
 
+#ifdef MULTIPLE_HEAPS
+// Called by each heap once it has traced everything reachable from its own roots
+// and cards, to help the heaps that are still marking. A heap's mark_deque can only
+// be non empty while that heap is counted in mark_steal_active_count (it always
+// takes back what wasn't stolen before mark_object_simple1 returns), so when the
+// count drops to 0 there is nothing left to steal anywhere.
+void gc_heap::steal_mark_work()
+{
+    assert (mark_deque.empty_p());
+    Interlocked::Decrement (&mark_steal_active_count);
+
+    int victim = (heap_number + 1) % n_heaps;
+    int idle_loop_count = 0;
+
+    while (mark_steal_active_count != 0)
+    {
+        uint8_t* o = nullptr;
+        for (int i = 0; i < n_heaps; i++)
+        {
+            int hn = (victim + i) % n_heaps;
+            gc_heap* hp = g_heaps[hn];
+            if ((hp == this) || hp->mark_deque.empty_p())
+            {
+                continue;
+            }
+
+            // count ourselves as active before taking the object so no heap
+            // concludes that marking is done while we are still tracing it
+            Interlocked::Increment (&mark_steal_active_count);
+            o = hp->mark_deque.steal();
+            if (o != nullptr)
+            {
+                victim = hn;
+                break;
+            }
+            Interlocked::Decrement (&mark_steal_active_count);
+        }
+
+        if (o != nullptr)
+        {
+            idle_loop_count = 0;
+            mark_steal_count++;
+            dprintf (4, ("h%d stole %zx from h%d", heap_number, (size_t)o, victim));
+            mark_object_simple1 (o, o, heap_number);
+            drain_mark_queue();
+            Interlocked::Decrement (&mark_steal_active_count);
+        }
+        else
+        {
+            idle_loop_count++;
+            if ((idle_loop_count % 64) == 0)
+            {
+                GCToOSInterface::YieldThread (0);
+            }
+            else
+            {
+                YieldProcessor();
+            }
+        }
+    }
+
+    // everyone is done, stop offering work for the rest of the mark phase
+    mark_steal_p = false;
+}
+#endif //MULTIPLE_HEAPS
+
 #ifdef BACKGROUND_GC
 
 #ifdef USE_REGIONS
@@ -29834,6 +30406,11 @@ void gc_heap::mark_phase (int condemned_gen_number)
     init_promoted_bytes();
 #endif //!USE_REGIONS || _DEBUG
     reset_mark_stack();
+#ifdef MULTIPLE_HEAPS
+    mark_steal_count = 0;
+    mark_steal_check_countdown = 0;
+    mark_steal_offer_cached_p = false;
+#endif //MULTIPLE_HEAPS
 
 #ifdef SNOOP_STATS
     memset (&snoop_stat, 0, sizeof(snoop_stat));
@@ -29961,6 +30538,9 @@ void gc_heap::mark_phase (int condemned_gen_number)
         }
 #endif //MH_SC_MARK
 
+        mark_steal_p = enable_mark_steal_p && (n_heaps > 1);
+        mark_steal_active_count = n_heaps;
+
         gc_t_join.restart();
 #endif //MULTIPLE_HEAPS
     }
@@ -30203,6 +30783,15 @@ void gc_heap::mark_phase (int condemned_gen_number)
     }
 #endif //MH_SC_MARK
 
+#ifdef MULTIPLE_HEAPS
+    if (mark_steal_p)
+    {
+        steal_mark_work();
+        dprintf (2, ("h%d stole %zd objects from other heaps", heap_number, mark_steal_count));
+        fire_mark_event (ETW::GC_ROOT_STEAL, current_promoted_bytes, last_promoted_bytes);
+    }
+#endif //MULTIPLE_HEAPS
+
     // Dependent handles need to be scanned with a special algorithm (see the header comment on
     // scan_dependent_handles for more detail). We perform an initial scan without synchronizing with other
     // worker threads or processing any mark stack overflow. This is not guaranteed to complete the operation
@@ -32902,6 +33491,7 @@ void gc_heap::plan_phase (int condemned_gen_number)
     memset (planned_regions_per_gen, 0, sizeof (planned_regions_per_gen));
     memset (sip_maxgen_regions_per_gen, 0, sizeof (sip_maxgen_regions_per_gen));
     memset (reserved_free_regions_sip, 0, sizeof (reserved_free_regions_sip));
+    decide_on_gen2_compact_regions();
     int pinned_survived_region = 0;
     uint8_t** mark_list_index = nullptr;
     uint8_t** mark_list_next = nullptr;
@@ -33180,7 +33770,12 @@ void gc_heap::plan_phase (int condemned_gen_number)
             dprintf (REGIONS_LOG, ("h%d setting seg %p pin surv: %d",
                 heap_number, heap_segment_mem (seg1), pinned_survived_region));
             pinned_survived_region = 0;
-            if (heap_segment_mem (seg1) == heap_segment_allocated (seg1))
+            if ((heap_segment_mem (seg1) == heap_segment_allocated (seg1))
+#ifdef MULTIPLE_HEAPS
+                // These are counted after they are swept.
+                && !(heap_segment_swept_in_plan (seg1) && parallel_sweep_in_plan_p())
+#endif //MULTIPLE_HEAPS
+                )
             {
                 num_regions_freed_in_sweep++;
             }
@@ -33667,6 +34262,13 @@ void gc_heap::plan_phase (int condemned_gen_number)
         x = find_next_marked (x, end, use_mark_list, mark_list_next, mark_list_index);
     }
 
+#if defined(USE_REGIONS) && defined(MULTIPLE_HEAPS)
+    if (parallel_sweep_in_plan_p())
+    {
+        sweep_deferred_regions_in_plan (condemned_gen_number);
+    }
+#endif //USE_REGIONS && MULTIPLE_HEAPS
+
 #ifndef USE_REGIONS
     while (!pinned_plug_que_empty_p())
     {
@@ -35237,6 +35839,69 @@ void gc_heap::update_start_tail_regions (generation* gen,
     verify_regions (false, settings.concurrent);
 }
 
+// Survival of a region in percent of a basic region, capped at 100.
+inline
+int gc_heap::get_region_surv_ratio (heap_segment* region)
+{
+    size_t basic_region_size = (size_t)1 << min_segment_size_shr;
+    return (int)min (((double)heap_segment_survived (region) * 100.0) / (double)basic_region_size, 100.0);
+}
+
+// On a big fragmented heap compacting all of gen2 makes the pause long enough that people would
+// rather turn compaction off. With GCGen2CompactRegions (and special regions enabled) a compacting
+// gen2 GC only evacuates the gen2 regions with the lowest survival ratio, up to the budget per heap,
+// and should_sweep_in_plan sweeps the rest in plan. This bounds the plan and compact work on gen2
+// by the number of regions chosen, and the next gen2 GC picks the next most fragmented regions.
+//
+// We pick the regions with a histogram of survival ratios so we don't need to sort.
+void gc_heap::decide_on_gen2_compact_regions()
+{
+    gen2_compact_bounded_p = false;
+
+    if ((gen2_compact_region_budget == 0) ||
+        !enable_special_regions_p ||
+        (settings.condemned_generation != max_generation) ||
+        (settings.reason == reason_induced_aggressive) ||
+        last_gc_before_oom)
+    {
+        return;
+    }
+
+    const int ratio_count = 101;
+    int regions_per_ratio[ratio_count];
+    memset (regions_per_ratio, 0, sizeof (regions_per_ratio));
+
+    int num_gen2_regions = 0;
+    for (heap_segment* region = heap_segment_rw (generation_start_segment (generation_of (max_generation)));
+         region != nullptr;
+         region = heap_segment_next_rw (region))
+    {
+        regions_per_ratio[get_region_surv_ratio (region)]++;
+        num_gen2_regions++;
+    }
+
+    if (num_gen2_regions <= gen2_compact_region_budget)
+    {
+        return;
+    }
+
+    int regions_below_th = 0;
+    int ratio_th = 0;
+    while ((regions_below_th + regions_per_ratio[ratio_th]) < gen2_compact_region_budget)
+    {
+        regions_below_th += regions_per_ratio[ratio_th];
+        ratio_th++;
+    }
+
+    gen2_compact_bounded_p = true;
+    gen2_compact_surv_ratio_th = ratio_th;
+    gen2_compact_regions_at_th = gen2_compact_region_budget - regions_below_th;
+
+    dprintf (REGIONS_LOG, ("h%d compacting %d of %d gen2 regions, surv ratio < %d%% and %d at %d%%",
+        heap_number, gen2_compact_region_budget, num_gen2_regions,
+        ratio_th, gen2_compact_regions_at_th, ratio_th));
+}
+
 // There's one complication with deciding whether we can make a region SIP or not - if the plan_gen_num of
 // a generation is not maxgen, and if we want to make every region in that generation maxgen, we need to
 // make sure we can get a new region for this generation so we can guarantee each generation has at least
@@ -35288,7 +35953,7 @@ bool gc_heap::should_sweep_in_plan (heap_segment* region)
         size_t basic_region_size = (size_t)1 << min_segment_size_shr;
         assert (heap_segment_gen_num (region) == heap_segment_plan_gen_num (region));
 
-        uint8_t surv_ratio = (uint8_t)(((double)heap_segment_survived (region) * 100.0) / (double)basic_region_size);
+        int surv_ratio = get_region_surv_ratio (region);
         dprintf (2222, ("SSIP: region %p surv %hu / %zd = %d%%(%d)",
             heap_segment_mem (region),
             heap_segment_survived (region),
@@ -35299,6 +35964,22 @@ bool gc_heap::should_sweep_in_plan (heap_segment* region)
             set_region_plan_gen_num (region, new_gen_num);
             sip_p = true;
         }
+        else if (gen2_compact_bounded_p && (gen_num == max_generation))
+        {
+            // Only the gen2 regions decide_on_gen2_compact_regions picked get compacted.
+            bool compact_p = (surv_ratio < gen2_compact_surv_ratio_th);
+            if (!compact_p && (surv_ratio == gen2_compact_surv_ratio_th) && (gen2_compact_regions_at_th > 0))
+            {
+                gen2_compact_regions_at_th--;
+                compact_p = true;
+            }
+
+            if (!compact_p)
+            {
+                set_region_plan_gen_num (region, max_generation);
+                sip_p = true;
+            }
+        }
 
         if (settings.promotion && (new_gen_num < max_generation))
         {
@@ -35385,6 +36066,9 @@ void heap_segment::thread_free_obj (uint8_t* obj, size_t s)
 //
 // in plan_phase we also need to make sure to not call update_brick_table when handling end of this region,
 // and the plan gen num is set accordingly.
+//
+// With Server GC the sweeping itself (everything but setting swept_in_plan_p and the plan gen's allocation
+// size) can be deferred till the end of the plan walk, see sweep_deferred_regions_in_plan.
 void gc_heap::sweep_region_in_plan (heap_segment* region,
                                     BOOL use_mark_list,
                                     uint8_t**& mark_list_next,
@@ -35392,6 +36076,32 @@ void gc_heap::sweep_region_in_plan (heap_segment* region,
 {
     set_region_sweep_in_plan (region);
 
+    int plan_gen_num = heap_segment_plan_gen_num (region);
+    if (plan_gen_num < heap_segment_gen_num (region))
+    {
+        generation_allocation_size (generation_of (plan_gen_num)) += heap_segment_survived (region);
+        dprintf (REGIONS_LOG, ("sip: g%d alloc size is now %zd", plan_gen_num,
+            generation_allocation_size (generation_of (plan_gen_num))));
+    }
+
+#ifdef MULTIPLE_HEAPS
+    if (parallel_sweep_in_plan_p())
+    {
+        num_sip_regions_deferred++;
+        dprintf (REGIONS_LOG, ("h%d deferring sweeping SIP region %p, %d deferred",
+            heap_number, heap_segment_mem (region), num_sip_regions_deferred));
+        return;
+    }
+#endif //MULTIPLE_HEAPS
+
+    sweep_region_in_plan_objects (region, use_mark_list, mark_list_next, mark_list_index);
+}
+
+void gc_heap::sweep_region_in_plan_objects (heap_segment* region,
+                                            BOOL use_mark_list,
+                                            uint8_t**& mark_list_next,
+                                            uint8_t** mark_list_index)
+{
     region->init_free_list();
 
     uint8_t* x = heap_segment_mem (region);
@@ -35510,15 +36220,127 @@ void gc_heap::sweep_region_in_plan (heap_segment* region,
     save_allocated(region);
     heap_segment_allocated (region) = last_marked_obj_end;
     heap_segment_plan_allocated (region) = heap_segment_allocated (region);
+}
 
-    int plan_gen_num = heap_segment_plan_gen_num (region);
-    if (plan_gen_num < heap_segment_gen_num (region))
+#ifdef MULTIPLE_HEAPS
+// Each heap's GC thread sweeps its own SIP regions during its plan walk, so a heap with many SIP
+// regions (common for gen1 GCs on heaps full of long lived cache objects) holds up everyone at the
+// compaction decision while the other GC threads are idle. Instead the plan walk only decides which
+// regions are SIP and the sweeping is done afterwards by all GC threads at region granularity.
+// The free objects are threaded onto each region's own free list, same as before, so there's
+// nothing to merge - they get threaded onto the generation's free list later as usual.
+//
+// This needs to be the same on all heaps since it decides whether we join.
+bool gc_heap::parallel_sweep_in_plan_p()
+{
+    return (enable_parallel_sweep_in_plan_p &&
+            (n_heaps > 1) &&
+            (settings.reason != reason_induced_aggressive) &&
+            (enable_special_regions_p ||
+             ((gen2_compact_region_budget != 0) && (settings.condemned_generation == max_generation))));
+}
+
+// Sweeps the deferred SIP regions of hp that this thread manages to claim. The SIP regions of hp are
+// numbered in the order of its condemned generations' region lists which don't change at this point.
+size_t gc_heap::sweep_deferred_regions_of_heap (gc_heap* hp, int condemned_gen_number)
+{
+    size_t regions_swept = 0;
+    int claimed_index = Interlocked::Increment (&hp->sip_sweep_claimed_count) - 1;
+    int sip_index = 0;
+
+    for (int gen_idx = condemned_gen_number; gen_idx >= 0; gen_idx--)
     {
-        generation_allocation_size (generation_of (plan_gen_num)) += heap_segment_survived (region);
-        dprintf (REGIONS_LOG, ("sip: g%d alloc size is now %zd", plan_gen_num,
-            generation_allocation_size (generation_of (plan_gen_num))));
+        heap_segment* region = heap_segment_rw (generation_start_segment (hp->generation_of (gen_idx)));
+
+        while (region && (claimed_index < hp->num_sip_regions_deferred))
+        {
+            if (heap_segment_swept_in_plan (region))
+            {
+                if (sip_index == claimed_index)
+                {
+                    // We don't use the mark list here - the portion for this region was already merged by
+                    // the plan walk and SIP regions are mostly live anyway.
+                    uint8_t** mark_list_next = nullptr;
+                    hp->sweep_region_in_plan_objects (region, FALSE, mark_list_next, nullptr);
+                    regions_swept++;
+
+                    claimed_index = Interlocked::Increment (&hp->sip_sweep_claimed_count) - 1;
+                }
+
+                sip_index++;
+            }
+
+            region = heap_segment_next_rw (region);
+        }
+    }
+
+    assert (claimed_index >= hp->num_sip_regions_deferred);
+    return regions_swept;
+}
+
+void gc_heap::sweep_deferred_regions_in_plan (int condemned_gen_number)
+{
+    gc_t_join.join (this, gc_join_sweep_in_plan);
+    if (gc_t_join.joined())
+    {
+        // Only worth another join if the SIP regions are not spread evenly.
+        int total_deferred = 0;
+        int max_deferred = 0;
+        for (int i = 0; i < n_heaps; i++)
+        {
+            total_deferred += g_heaps[i]->num_sip_regions_deferred;
+            max_deferred = max (max_deferred, g_heaps[i]->num_sip_regions_deferred);
+        }
+
+        const int min_deferred_to_steal = 4;
+        sip_sweep_steal_p = ((max_deferred >= min_deferred_to_steal) &&
+                             ((max_deferred * n_heaps) >= (total_deferred * 3 / 2)));
+
+        dprintf (REGIONS_LOG, ("%d SIP regions deferred, at most %d on one heap, %s",
+            total_deferred, max_deferred, (sip_sweep_steal_p ? "sharing" : "not sharing")));
+
+        gc_t_join.restart();
+    }
+
+    size_t regions_swept = 0;
+    int heaps_to_sweep = (sip_sweep_steal_p ? n_heaps : 1);
+    for (int hn = 0; hn < heaps_to_sweep; hn++)
+    {
+        gc_heap* hp = g_heaps[(heap_number + hn) % n_heaps];
+        if (hp->sip_sweep_claimed_count < hp->num_sip_regions_deferred)
+        {
+            regions_swept += sweep_deferred_regions_of_heap (hp, condemned_gen_number);
+        }
+    }
+
+    if (sip_sweep_steal_p)
+    {
+        // Our regions could've been swept by other threads.
+        gc_t_join.join (this, gc_join_sweep_in_plan_done);
+        if (gc_t_join.joined())
+        {
+            gc_t_join.restart();
+        }
     }
+
+    // The plan walk didn't count the deferred regions that sweeping emptied.
+    for (int gen_idx = condemned_gen_number; gen_idx >= 0; gen_idx--)
+    {
+        heap_segment* region = heap_segment_rw (generation_start_segment (generation_of (gen_idx)));
+        while (region)
+        {
+            if (heap_segment_swept_in_plan (region) && (heap_segment_mem (region) == heap_segment_allocated (region)))
+            {
+                num_regions_freed_in_sweep++;
+            }
+            region = heap_segment_next_rw (region);
+        }
+    }
+
+    dprintf (REGIONS_LOG, ("h%d swept %zd of %d deferred SIP regions, %d regions freed",
+        heap_number, regions_swept, num_sip_regions_deferred, num_regions_freed_in_sweep));
 }
+#endif //MULTIPLE_HEAPS
 
 inline
 void gc_heap::check_demotion_helper_sip (uint8_t** pval, int parent_gen_num, uint8_t* parent_loc)
@@ -38642,6 +39464,11 @@ void gc_heap::background_mark_phase ()
         for (int i = 0; i < n_heaps; i++)
         {
             g_heaps[i]->current_bgc_state = bgc_mark_handles;
+#ifdef USE_REGIONS
+            g_heaps[i]->bgc_revisit_pass = 0;
+            g_heaps[i]->bgc_revisit_claimed_count[0] = 0;
+            g_heaps[i]->bgc_revisit_claimed_count[1] = 0;
+#endif //USE_REGIONS
         }
 #else
         current_bgc_state = bgc_mark_handles;
@@ -38696,6 +39523,23 @@ void gc_heap::background_mark_phase ()
 
     // tuning has shown that there are advantages in doing this 2 times
     revisit_written_pages (TRUE);
+
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    if (enable_bgc_parallel_revisit_p)
+    {
+        // gen2 regions are claimed across heaps separately in each pass so a thread
+        // must not start the 2nd pass while another thread is still revisiting a
+        // region in the 1st - that'd have 2 threads revisiting the same region.
+        enable_preemptive ();
+        bgc_t_join.join(this, gc_join_concurrent_revisit);
+        if (bgc_t_join.joined())
+        {
+            bgc_t_join.restart();
+        }
+        disable_preemptive (true);
+    }
+#endif //MULTIPLE_HEAPS && USE_REGIONS
+
     revisit_written_pages (TRUE);
 
     //concurrent_print_time_delta ("concurrent marking dirtied pages on LOH");
@@ -39280,164 +40124,226 @@ end_limit:
     }
 }
 
-// When reset_only_p is TRUE, we should only reset pages that are in range
-// because we need to consider the segments or part of segments that were
-// allocated out of range all live.
-void gc_heap::revisit_written_pages (BOOL concurrent_p, BOOL reset_only_p)
+void gc_heap::revisit_written_seg (heap_segment* seg, BOOL concurrent_p, BOOL reset_only_p,
+                                   BOOL small_object_segments, size_t& total_dirtied_pages,
+                                   size_t& total_marked_objects)
 {
-    if (concurrent_p && !reset_only_p)
-    {
-        current_bgc_state = bgc_revisit_soh;
-    }
-
-    size_t total_dirtied_pages = 0;
-    size_t total_marked_objects = 0;
-
     bool reset_watch_state = !!concurrent_p;
     bool is_runtime_suspended = !concurrent_p;
-    BOOL small_object_segments = TRUE;
-    int start_gen_idx = get_start_generation_index();
-#ifdef USE_REGIONS
-    if (concurrent_p && !reset_only_p)
+
+    uint8_t* base_address = (uint8_t*)heap_segment_mem (seg);
+    //we need to truncate to the base of the page because
+    //some newly allocated could exist beyond heap_segment_allocated
+    //and if we reset the last page write watch status,
+    // they wouldn't be guaranteed to be visited -> gc hole.
+    uintptr_t bcount = array_size;
+    uint8_t* last_page = 0;
+    uint8_t* last_object = heap_segment_mem (seg);
+    uint8_t* high_address = 0;
+
+    BOOL skip_seg_p = FALSE;
+
+    if (reset_only_p)
     {
-        // We don't go into ephemeral regions during concurrent revisit.
-        start_gen_idx = max_generation;
+        if ((heap_segment_mem (seg) >= background_saved_lowest_address) ||
+            (heap_segment_reserved (seg) <= background_saved_highest_address))
+        {
+            dprintf (3, ("h%d: sseg: %p(-%p)", heap_number,
+                heap_segment_mem (seg), heap_segment_reserved (seg)));
+            skip_seg_p = TRUE;
+        }
     }
-#endif //USE_REGIONS
 
-    for (int i = start_gen_idx; i < total_generation_count; i++)
+    if (!skip_seg_p)
     {
-        heap_segment* seg = heap_segment_rw (generation_start_segment (generation_of (i)));
-        PREFIX_ASSUME(seg != NULL);
+        dprintf (3, ("looking at seg %zx", (size_t)last_object));
 
-        while (seg)
+        if (reset_only_p)
         {
-            uint8_t* base_address = (uint8_t*)heap_segment_mem (seg);
-            //we need to truncate to the base of the page because
-            //some newly allocated could exist beyond heap_segment_allocated
-            //and if we reset the last page write watch status,
-            // they wouldn't be guaranteed to be visited -> gc hole.
-            uintptr_t bcount = array_size;
-            uint8_t* last_page = 0;
-            uint8_t* last_object = heap_segment_mem (seg);
-            uint8_t* high_address = 0;
+            base_address = max (base_address, background_saved_lowest_address);
+            dprintf (3, ("h%d: reset only starting %p", heap_number, base_address));
+        }
+
+        dprintf (3, ("h%d: starting: %p, seg %p-%p", heap_number, base_address,
+            heap_segment_mem (seg), heap_segment_reserved (seg)));
 
-            BOOL skip_seg_p = FALSE;
 
+        while (1)
+        {
             if (reset_only_p)
             {
-                if ((heap_segment_mem (seg) >= background_saved_lowest_address) ||
-                    (heap_segment_reserved (seg) <= background_saved_highest_address))
-                {
-                    dprintf (3, ("h%d: sseg: %p(-%p)", heap_number,
-                        heap_segment_mem (seg), heap_segment_reserved (seg)));
-                    skip_seg_p = TRUE;
-                }
+                high_address = ((seg == ephemeral_heap_segment) ? alloc_allocated : heap_segment_allocated (seg));
+                high_address = min (high_address, background_saved_highest_address);
+            }
+            else
+            {
+                high_address = high_page (seg, concurrent_p);
             }
 
-            if (!skip_seg_p)
+            if ((base_address < high_address) &&
+                (bcount >= array_size))
             {
-                dprintf (3, ("looking at seg %zx", (size_t)last_object));
+                ptrdiff_t region_size = high_address - base_address;
+                dprintf (3, ("h%d: gw: [%zx(%zd)", heap_number, (size_t)base_address, (size_t)region_size));
 
-                if (reset_only_p)
+#ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
+                // When the runtime is not suspended, it's possible for the table to be resized concurrently with the scan
+                // for dirty pages below. Prevent that by synchronizing with grow_brick_card_tables(). When the runtime is
+                // suspended, it's ok to scan for dirty pages concurrently from multiple background GC threads for disjoint
+                // memory regions.
+                if (!is_runtime_suspended)
                 {
-                    base_address = max (base_address, background_saved_lowest_address);
-                    dprintf (3, ("h%d: reset only starting %p", heap_number, base_address));
+                    enter_spin_lock(&gc_lock);
                 }
+#endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
 
-                dprintf (3, ("h%d: starting: %p, seg %p-%p", heap_number, base_address,
-                    heap_segment_mem (seg), heap_segment_reserved (seg)));
+                get_write_watch_for_gc_heap (reset_watch_state, base_address, region_size,
+                                             (void**)background_written_addresses,
+                                             &bcount, is_runtime_suspended);
 
+#ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
+                if (!is_runtime_suspended)
+                {
+                    leave_spin_lock(&gc_lock);
+                }
+#endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
 
-                while (1)
+                if (bcount != 0)
                 {
-                    if (reset_only_p)
-                    {
-                        high_address = ((seg == ephemeral_heap_segment) ? alloc_allocated : heap_segment_allocated (seg));
-                        high_address = min (high_address, background_saved_highest_address);
-                    }
-                    else
-                    {
-                        high_address = high_page (seg, concurrent_p);
-                    }
+                    total_dirtied_pages += bcount;
 
-                    if ((base_address < high_address) &&
-                        (bcount >= array_size))
-                    {
-                        ptrdiff_t region_size = high_address - base_address;
-                        dprintf (3, ("h%d: gw: [%zx(%zd)", heap_number, (size_t)base_address, (size_t)region_size));
+                    dprintf (3, ("Found %zu pages [%zx, %zx[",
+                                    bcount, (size_t)base_address, (size_t)high_address));
+                }
 
-#ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
-                        // When the runtime is not suspended, it's possible for the table to be resized concurrently with the scan
-                        // for dirty pages below. Prevent that by synchronizing with grow_brick_card_tables(). When the runtime is
-                        // suspended, it's ok to scan for dirty pages concurrently from multiple background GC threads for disjoint
-                        // memory regions.
-                        if (!is_runtime_suspended)
+                if (!reset_only_p)
+                {
+                    // refetch the high address in case it has changed while we fetched dirty pages
+                    // this is only an issue for the page high_address is on - we may have new
+                    // objects after high_address.
+                    high_address = high_page (seg, concurrent_p);
+
+                    for (unsigned i = 0; i < bcount; i++)
+                    {
+                        uint8_t* page = (uint8_t*)background_written_addresses[i];
+                        dprintf (3, ("looking at page %d at %zx(h: %zx)", i,
+                            (size_t)page, (size_t)high_address));
+                        if (page < high_address)
                         {
-                            enter_spin_lock(&gc_lock);
+                            //search for marked objects in the page
+                            revisit_written_page (page, high_address, concurrent_p,
+                                                  last_page, last_object,
+                                                  !small_object_segments,
+                                                  total_marked_objects);
                         }
-#endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
-
-                        get_write_watch_for_gc_heap (reset_watch_state, base_address, region_size,
-                                                     (void**)background_written_addresses,
-                                                     &bcount, is_runtime_suspended);
-
-#ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
-                        if (!is_runtime_suspended)
+                        else
                         {
-                            leave_spin_lock(&gc_lock);
+                            dprintf (3, ("page %d at %zx is >= %zx!", i, (size_t)page, (size_t)high_address));
+                            assert (!"page shouldn't have exceeded limit");
                         }
-#endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
+                    }
+                }
 
-                        if (bcount != 0)
-                        {
-                            total_dirtied_pages += bcount;
+                if (bcount >= array_size){
+                    base_address = background_written_addresses [array_size-1] + WRITE_WATCH_UNIT_SIZE;
+                    bcount = array_size;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+}
 
-                            dprintf (3, ("Found %zu pages [%zx, %zx[",
-                                            bcount, (size_t)base_address, (size_t)high_address));
-                        }
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+// Without this each BGC thread only revisits the gen2 regions of its own heap, so
+// the heap with the most dirtied regions holds everyone at gc_join_concurrent_overflow
+// while the other BGC threads are idle. Instead BGC threads claim gen2 regions from
+// every heap, starting with their own, and revisit whatever they claimed - the
+// marking is done on the claiming thread's mark stack which is fine since background
+// marking can already mark objects that belong to other heaps. UOH regions are still
+// revisited by their own heap's thread because that's synchronized with the allocator
+// via the per heap bgc_alloc_lock.
+void gc_heap::revisit_written_regions_parallel (size_t& total_dirtied_pages, size_t& total_marked_objects)
+{
+    int pass = bgc_revisit_pass;
+    assert (pass < (int)(sizeof (bgc_revisit_claimed_count) / sizeof (bgc_revisit_claimed_count[0])));
+    size_t regions_revisited = 0;
+
+    for (int hn = 0; hn < n_heaps; hn++)
+    {
+        gc_heap* hp = g_heaps[(heap_number + hn) % n_heaps];
+        heap_segment* seg = heap_segment_rw (generation_start_segment (hp->generation_of (max_generation)));
+        int seg_index = 0;
 
-                        if (!reset_only_p)
-                        {
-                            // refetch the high address in case it has changed while we fetched dirty pages
-                            // this is only an issue for the page high_address is on - we may have new
-                            // objects after high_address.
-                            high_address = high_page (seg, concurrent_p);
+        while (seg)
+        {
+            int claimed_index = Interlocked::Increment (&hp->bgc_revisit_claimed_count[pass]) - 1;
 
-                            for (unsigned i = 0; i < bcount; i++)
-                            {
-                                uint8_t* page = (uint8_t*)background_written_addresses[i];
-                                dprintf (3, ("looking at page %d at %zx(h: %zx)", i,
-                                    (size_t)page, (size_t)high_address));
-                                if (page < high_address)
-                                {
-                                    //search for marked objects in the page
-                                    revisit_written_page (page, high_address, concurrent_p,
-                                                          last_page, last_object,
-                                                          !small_object_segments,
-                                                          total_marked_objects);
-                                }
-                                else
-                                {
-                                    dprintf (3, ("page %d at %zx is >= %zx!", i, (size_t)page, (size_t)high_address));
-                                    assert (!"page shouldn't have exceeded limit");
-                                }
-                            }
-                        }
+            while (seg && (seg_index < claimed_index))
+            {
+                seg = heap_segment_next_rw (seg);
+                seg_index++;
+            }
 
-                        if (bcount >= array_size){
-                            base_address = background_written_addresses [array_size-1] + WRITE_WATCH_UNIT_SIZE;
-                            bcount = array_size;
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
+            if (seg == nullptr)
+            {
+                break;
             }
 
-            seg = heap_segment_next_rw (seg);
+            revisit_written_seg (seg, TRUE, FALSE, TRUE, total_dirtied_pages, total_marked_objects);
+            regions_revisited++;
+        }
+    }
+
+    dprintf (GTC_LOG, ("h%d: pass %d revisited %zd gen2 regions", heap_number, pass, regions_revisited));
+}
+#endif //MULTIPLE_HEAPS && USE_REGIONS
+
+// When reset_only_p is TRUE, we should only reset pages that are in range
+// because we need to consider the segments or part of segments that were
+// allocated out of range all live.
+void gc_heap::revisit_written_pages (BOOL concurrent_p, BOOL reset_only_p)
+{
+    if (concurrent_p && !reset_only_p)
+    {
+        current_bgc_state = bgc_revisit_soh;
+    }
+
+    size_t total_dirtied_pages = 0;
+    size_t total_marked_objects = 0;
+
+    BOOL small_object_segments = TRUE;
+    int start_gen_idx = get_start_generation_index();
+#ifdef USE_REGIONS
+    if (concurrent_p && !reset_only_p)
+    {
+        // We don't go into ephemeral regions during concurrent revisit.
+        start_gen_idx = max_generation;
+    }
+#endif //USE_REGIONS
+
+    for (int i = start_gen_idx; i < total_generation_count; i++)
+    {
+        heap_segment* seg = heap_segment_rw (generation_start_segment (generation_of (i)));
+        PREFIX_ASSUME(seg != NULL);
+
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+        if (concurrent_p && !reset_only_p && (i == soh_gen2) && enable_bgc_parallel_revisit_p)
+        {
+            revisit_written_regions_parallel (total_dirtied_pages, total_marked_objects);
+        }
+        else
+#endif //MULTIPLE_HEAPS && USE_REGIONS
+        {
+            while (seg)
+            {
+                revisit_written_seg (seg, concurrent_p, reset_only_p, small_object_segments,
+                                     total_dirtied_pages, total_marked_objects);
+                seg = heap_segment_next_rw (seg);
+            }
         }
 
         if (i == soh_gen2)
@@ -39472,6 +40378,13 @@ void gc_heap::revisit_written_pages (BOOL concurrent_p, BOOL reset_only_p)
             }
         }
     }
+
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    if (concurrent_p && !reset_only_p)
+    {
+        bgc_revisit_pass++;
+    }
+#endif //MULTIPLE_HEAPS && USE_REGIONS
 }
 
 void gc_heap::background_grow_c_mark_list()
@@ -41474,6 +42387,14 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
                 else
                 {
                     cardb += sizeof(cbw)*8 - card_bundle_bit (cardb);
+
+                    // Skip the card bundle words that are all zero in one go
+                    if (cardb < end_cardb)
+                    {
+                        uint32_t* cbw_start = &card_bundle_table[card_bundle_word (cardb)];
+                        uint32_t* cbw_end = &card_bundle_table[card_bundle_word (end_cardb - 1) + 1];
+                        cardb += (find_nonzero_word (cbw_start, cbw_end) - cbw_start) * card_bundle_word_width;
+                    }
                 }
             }
             if (cardb >= end_cardb)
@@ -41481,10 +42402,7 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
 
             uint32_t* card_word = &card_table[max(card_bundle_cardw (cardb),cardw)];
             uint32_t* card_word_end = &card_table[min(card_bundle_cardw (cardb+1),cardw_end)];
-            while ((card_word < card_word_end) && !(*card_word))
-            {
-                card_word++;
-            }
+            card_word = find_nonzero_word (card_word, card_word_end);
 
             if (card_word != card_word_end)
             {
@@ -41498,10 +42416,7 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
             }
             // explore the end of the card bundle so we can possibly clear it
             card_word_end = &card_table[card_bundle_cardw (cardb+1)];
-            while ((card_word < card_word_end) && !(*card_word))
-            {
-                card_word++;
-            }
+            card_word = find_nonzero_word (card_word, card_word_end);
             if ((cardw <= card_bundle_cardw (cardb)) &&
                 (card_word == card_word_end))
             {
@@ -41521,15 +42436,11 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
         uint32_t* card_word = &card_table[cardw];
         uint32_t* card_word_end = &card_table [cardw_end];
 
-        while (card_word < card_word_end)
+        card_word = find_nonzero_word (card_word, card_word_end);
+        if (card_word != card_word_end)
         {
-            if ((*card_word) != 0)
-            {
-                cardw = (card_word - &card_table [0]);
-                return TRUE;
-            }
-
-            card_word++;
+            cardw = (card_word - &card_table [0]);
+            return TRUE;
         }
         return FALSE;
 
@@ -41589,12 +42500,7 @@ BOOL gc_heap::find_card(uint32_t* card_table,
 #else //CARD_BUNDLE
         // Go through the remaining card words between here and card_word_end until we find
         // one that is non-zero.
-        do
-        {
-            ++last_card_word;
-        }
-
-        while ((last_card_word < &card_table [card_word_end]) && !(*last_card_word));
+        last_card_word = find_nonzero_word ((last_card_word + 1), &card_table [card_word_end]);
         if (last_card_word < &card_table [card_word_end])
         {
             card_word_value = *last_card_word;
@@ -44917,6 +45823,186 @@ size_t gc_heap::decommit_ephemeral_segment_pages_step ()
     }
     return size;
 }
+
+#ifdef USE_REGIONS
+// Commits the free basic regions each heap will hand out to gen0 next, so the allocating
+// threads don't take the commit and the page faults on their allocation path. With
+// clear_ahead_p we also clear what was used in them before, so adjust_limit_clr doesn't
+// need to clear the allocation contexts it hands out there either. Called on
+// the heap#0 GC thread between GCs. Returns whether there's more to commit.
+bool gc_heap::commit_ahead_step()
+{
+    if ((settings.pause_mode == pause_no_gc) || (heap_hard_limit != 0))
+    {
+        return false;
+    }
+
+    // we commit at the same rate we decommit at
+    bool more_p = false;
+    size_t commit_size = 0;
+    for (int i = 0; i < n_heaps; i++)
+    {
+        gc_heap* hp = gc_heap::g_heaps[i];
+        commit_size += hp->commit_ahead_free_regions (max_decommit_step_size, &more_p);
+    }
+
+    dprintf (REGIONS_LOG, ("commit_ahead_step committed %zd bytes, more: %d", commit_size, more_p));
+    return more_p;
+}
+
+// Called with the more space lock held. Returns the first of the free basic regions gen0 is going to
+// use before the next GC that still needs clearing or committing and takes it off the free list, so
+// commit_ahead_region_pages can work on it without holding the more space lock. Returns nullptr if
+// there's no such region.
+heap_segment* gc_heap::get_commit_ahead_region()
+{
+    // we only want to have what gen0 is going to consume before the next GC committed
+    size_t region_size = global_region_allocator.get_region_alignment();
+    size_t target_regions = min (commit_ahead_max_regions,
+        (dd_desired_allocation (dynamic_data_of (0)) / region_size) + 1);
+
+    heap_segment* region = free_regions[basic_free_region].get_first_free_region();
+    for (size_t region_index = 0; (region != nullptr) && (region_index < target_regions); region_index++)
+    {
+        if ((clear_ahead_p && (heap_segment_used (region) > heap_segment_mem (region))) ||
+            (heap_segment_committed (region) < heap_segment_reserved (region)))
+        {
+            region_free_list::unlink_region (region);
+            return region;
+        }
+        region = heap_segment_next (region);
+    }
+
+    return nullptr;
+}
+
+// Called with the more space lock held, puts the region we were working on back at the front of
+// the basic free list where the allocator picks its next region. This also accounts what we
+// committed to the free list, unlink_region took the region's committed size off it before.
+void gc_heap::return_commit_ahead_region()
+{
+    if (commit_ahead_region != nullptr)
+    {
+        free_regions[basic_free_region].add_region_front (commit_ahead_region);
+        commit_ahead_region = nullptr;
+    }
+}
+
+// Clears and commits up to max_size bytes of a region get_commit_ahead_region took off the free list.
+// This is done without the more space lock since nobody else can see the region. Returns the size
+// cleared and committed.
+size_t gc_heap::commit_ahead_region_pages (heap_segment* region, size_t max_size, bool* commit_failed_p)
+{
+    size_t size = 0;
+    uint8_t* mem = heap_segment_mem (region);
+    uint8_t* used = heap_segment_used (region);
+    if (clear_ahead_p && (used > mem))
+    {
+        // clear from the end so we can stop anywhere and keep used valid
+        size_t clear_size = min ((size_t)(used - mem), max_size);
+        uint8_t* clear_start = used - clear_size;
+        memclr (clear_start, clear_size);
+        heap_segment_used (region) = clear_start;
+
+        dprintf (REGIONS_LOG, ("h%d cleared ahead %zd bytes of free region %p [%p-%p)",
+            heap_number, clear_size, region, clear_start, used));
+
+        size += clear_size;
+        if (size >= max_size)
+        {
+            return size;
+        }
+    }
+
+    uint8_t* committed = heap_segment_committed (region);
+    uint8_t* reserved = heap_segment_reserved (region);
+    if (committed < reserved)
+    {
+        size_t commit_size = min ((size_t)(reserved - committed), max_size - size);
+        commit_size = align_on_page (commit_size);
+        if (!virtual_commit (committed, commit_size, soh, heap_number))
+        {
+            // we'll just let the allocator commit the rest the way it usually does
+            *commit_failed_p = true;
+            return size;
+        }
+
+        // free regions have their committed size accounted to the free bucket
+        check_commit_cs.Enter();
+        assert (committed_by_oh[soh] >= commit_size);
+        committed_by_oh[soh] -= commit_size;
+        committed_by_oh[recorded_committed_free_bucket] += commit_size;
+#ifdef _DEBUG
+        committed_by_oh_per_heap[soh] -= commit_size;
+#endif //_DEBUG
+        check_commit_cs.Leave();
+
+        heap_segment_committed (region) = committed + commit_size;
+
+        // touch the pages now so the allocator doesn't take the faults - the memory is
+        // freshly committed so it's zero and stays zero, which keeps used valid
+        for (uint8_t* page = committed; page < (committed + commit_size); page += OS_PAGE_SIZE)
+        {
+            *(volatile uint8_t*)page = 0;
+        }
+
+        dprintf (REGIONS_LOG, ("h%d committed ahead %zd bytes of free region %p [%p-%p)",
+            heap_number, commit_size, region, committed, (committed + commit_size)));
+
+        size += commit_size;
+    }
+
+    return size;
+}
+
+// returns the size committed and cleared
+size_t gc_heap::commit_ahead_free_regions (size_t max_size, bool* more_p)
+{
+    size_t size = 0;
+    bool commit_failed_p = false;
+
+    while (true)
+    {
+        // gen0 takes its new regions from the basic free list under the more space lock -
+        // see decommit_ephemeral_segment_pages_step for why we can only try to take it here.
+        // We only hold it to move a region off and back on the free list, the clearing and
+        // committing is done without it so we don't hold up the allocating threads.
+        if (!try_enter_spin_lock (&more_space_lock_soh))
+        {
+            // if we are still holding on to a region, the next step or GC puts it back
+            *more_p = true;
+            break;
+        }
+        add_saved_spinlock_info (false, me_acquire, mt_commit_ahead, msl_entered);
+
+        return_commit_ahead_region();
+
+        heap_segment* region = nullptr;
+        if (!commit_failed_p && (size < max_size))
+        {
+            region = get_commit_ahead_region();
+            commit_ahead_region = region;
+        }
+
+        add_saved_spinlock_info (false, me_release, mt_commit_ahead, msl_entered);
+        leave_spin_lock (&more_space_lock_soh);
+
+        if (region == nullptr)
+        {
+            break;
+        }
+
+        size += commit_ahead_region_pages (region, (max_size - size), &commit_failed_p);
+    }
+
+    if (!commit_failed_p && (size >= max_size))
+    {
+        *more_p = true;
+    }
+
+    return size;
+}
+#endif //USE_REGIONS
 #endif //MULTIPLE_HEAPS
 
 //This is meant to be called by decide_on_compacting.
@@ -46696,8 +47782,8 @@ void gc_heap::background_sweep()
                 {
                     // we can treat all UOH segments as in the bgc domain
                     // regardless of whether we saw in bgc mark or not
-                    // because we don't allow UOH allocations during bgc
-                    // sweep anyway - the UOH segments can't change.
+                    // because we don't allow UOH allocations while we
+                    // sweep a UOH segment - it can't change.
                     process_background_segment_end (seg, gen, plug_end,
                                                     start_seg, &delete_p, 0);
                 }
@@ -46743,6 +47829,13 @@ void gc_heap::background_sweep()
                 saved_prev_seg, (saved_prev_seg ? heap_segment_mem (saved_prev_seg) : 0),
                 (delete_p ? 1 : 0)));
             seg = next_seg;
+
+#ifdef USE_REGIONS
+            if ((i > max_generation) && seg && enable_bgc_uoh_sweep_per_region_p)
+            {
+                bgc_uoh_sweep_allow_alloc();
+            }
+#endif //USE_REGIONS
         }
 
         generation_allocation_segment (gen) = heap_segment_rw (generation_start_segment (gen));
@@ -49090,11 +50183,20 @@ HRESULT GCHeap::Initialize()
 
     GCConfig::SetHeapCount(static_cast<int64_t>(nhp));
 
+#ifdef MULTIPLE_HEAPS
+    gc_heap::enable_mark_steal_p = GCConfig::GetGCMarkSteal();
+    gc_heap::enable_bgc_parallel_revisit_p = GCConfig::GetGCBGCParallelRevisit();
+#ifdef USE_REGIONS
+    gc_heap::enable_parallel_sweep_in_plan_p = GCConfig::GetGCParallelSweepInPlan();
+#endif //USE_REGIONS
+#endif //MULTIPLE_HEAPS
+
     loh_size_threshold = (size_t)GCConfig::GetLOHThreshold();
     loh_size_threshold = max (loh_size_threshold, LARGE_OBJECT_SIZE);
 
 #ifdef USE_REGIONS
     gc_heap::enable_special_regions_p = (bool)GCConfig::GetGCEnableSpecialRegions();
+    gc_heap::gen2_compact_region_budget = max ((int)GCConfig::GetGCGen2CompactRegions(), 0);
     size_t gc_region_size = (size_t)GCConfig::GetGCRegionSize();
 
     if (gc_region_size >= MAX_REGION_SIZE)
@@ -49161,6 +50263,17 @@ HRESULT GCHeap::Initialize()
     GCConfig::SetLOHThreshold(loh_size_threshold);
 
     gc_heap::min_segment_size_shr = index_of_highest_set_bit (gc_region_size);
+
+    if (GCConfig::GetGCRegionHugePages() && !gc_heap::use_large_pages_p)
+    {
+        // Huge pages are only worth it if a basic region holds at least one of them.
+        size_t huge_page_size = GCToOSInterface::GetTransparentHugePageSize();
+        if ((huge_page_size != 0) && (huge_page_size <= gc_region_size))
+        {
+            gc_heap::region_huge_page_size = huge_page_size;
+        }
+    }
+    GCConfig::SetGCRegionHugePages(gc_heap::region_huge_page_size != 0);
 #else
     gc_heap::min_segment_size_shr = index_of_highest_set_bit (gc_heap::min_segment_size);
 #endif //USE_REGIONS
@@ -49365,6 +50478,12 @@ HRESULT GCHeap::Initialize()
             {
                 gc_heap::dynamic_heap_count_data.target_tcp = (float)target_tcp;
             }
+            int target_pause_ms = (int)GCConfig::GetGCPauseTargetMs();
+            if (target_pause_ms > 0)
+            {
+                gc_heap::dynamic_heap_count_data.target_pause_us = (uint64_t)target_pause_ms * 1000;
+                dprintf (6666, ("datas pause target %dms", target_pause_ms));
+            }
             // This should be adjusted based on the target tcp. See comments in gcpriv.h
             gc_heap::dynamic_heap_count_data.around_target_threshold = 10.0;
             // This should really be set as part of computing static data and should take conserve_mem_setting into consideration.
@@ -52068,12 +53187,19 @@ bool CFinalize::Initialize()
     lockowner_threadid.Clear();
 #endif // _DEBUG
 
+    // if we can't get the pending array we just always take the lock
+    m_PendingArray = new (nothrow)(Object*[PendingCapacity]);
+    m_PendingCount = 0;
+    m_PendingLimit = 0;
+    ResetPendingRegistrations();
+
     return true;
 }
 
 CFinalize::~CFinalize()
 {
     delete[] m_Array;
+    delete[] m_PendingArray;
 }
 
 size_t CFinalize::GetPromotedCount ()
@@ -52183,14 +53309,27 @@ CFinalize::RegisterForFinalization (int gen, Object* obj, size_t size)
         GC_NOTRIGGER;
     } CONTRACTL_END;
 
-    EnterFinalizeLock();
-
     // Adjust gen
     unsigned int dest = gen_segment (gen);
 
-    // Adjust boundary for segments so that GC will keep objects alive.
-    Object*** s_i = &SegQueue (FreeListSeg);
-    if ((*s_i) == SegQueueLimit(FreeListSeg))
+    // Almost all registrations come from allocations and go to gen0. Claim a pending
+    // slot for those instead of taking the finalize lock - this is safe because we
+    // cannot be suspended for a GC between claiming the slot and storing into it.
+    if ((dest == gen_segment (0)) && (m_PendingCount < m_PendingLimit))
+    {
+        int32_t index = Interlocked::Increment (&m_PendingCount) - 1;
+        if (index < m_PendingLimit)
+        {
+            m_PendingArray[index] = obj;
+            return true;
+        }
+    }
+
+    EnterFinalizeLock();
+
+    // Adjust boundary for segments so that GC will keep objects alive. The slots
+    // reserved for pending registrations are not available here.
+    while ((size_t)(SegQueueLimit (FreeListSeg) - SegQueue (FreeListSeg)) <= (size_t)m_PendingLimit)
     {
         if (!GrowArray())
         {
@@ -52210,6 +53349,22 @@ CFinalize::RegisterForFinalization (int gen, Object* obj, size_t size)
             return false;
         }
     }
+
+    InsertItem (obj, dest);
+
+    LeaveFinalizeLock();
+
+    return true;
+}
+
+// Stores obj into the dest segment. The caller either holds the finalize lock
+// or is the GC, and has made sure there is at least one free slot.
+void
+CFinalize::InsertItem (Object* obj, unsigned int dest)
+{
+    Object*** s_i = &SegQueue (FreeListSeg);
+    assert ((*s_i) < SegQueueLimit (FreeListSeg));
+
     Object*** end_si = &SegQueueLimit (dest);
     do
     {
@@ -52230,10 +53385,52 @@ CFinalize::RegisterForFinalization (int gen, Object* obj, size_t size)
     **s_i = obj;
     // increment the fill pointer
     (*s_i)++;
+}
 
-    LeaveFinalizeLock();
+// Moves the registrations made without the finalize lock into the gen0 segment.
+// This is only called during a GC, so no other thread can be registering.
+void
+CFinalize::DrainPendingRegistrations()
+{
+    int32_t count = min ((int32_t)m_PendingCount, m_PendingLimit);
+    if (count > 0)
+    {
+        dprintf (3, ("moving %d pending finalizer registrations into the queue", count));
+    }
 
-    return true;
+    for (int32_t i = 0; i < count; i++)
+    {
+        InsertItem (m_PendingArray[i], gen_segment (0));
+    }
+
+    ResetPendingRegistrations();
+}
+
+// Decides how many pending slots we can hand out until the next GC, which is
+// however many we can guarantee room for in the free list segment.
+void
+CFinalize::ResetPendingRegistrations()
+{
+    m_PendingCount = 0;
+    m_PendingLimit = 0;
+
+    if (!m_PendingArray)
+    {
+        return;
+    }
+
+    size_t free_count = SegQueueLimit (FreeListSeg) - SegQueue (FreeListSeg);
+    while (free_count <= (size_t)PendingCapacity)
+    {
+        if (!GrowArray())
+        {
+            break;
+        }
+        free_count = SegQueueLimit (FreeListSeg) - SegQueue (FreeListSeg);
+    }
+
+    // leave some room for the registrations that still need to take the lock
+    m_PendingLimit = (int32_t)min (free_count / 2, (size_t)PendingCapacity);
 }
 
 Object*
@@ -52358,6 +53555,8 @@ CFinalize::ScanForFinalization (promote_func* pfn, int gen, gc_heap* hp)
 
     BOOL finalizedFound = FALSE;
 
+    DrainPendingRegistrations();
+
     //start with gen and explore all the younger generations.
     unsigned int startSeg = gen_segment (gen);
     {
@@ -52558,6 +53757,9 @@ CFinalize::GrowArray()
 // return false in case of failure - in this case, move no items
 bool CFinalize::MergeFinalizationData (CFinalize* other_fq)
 {
+    DrainPendingRegistrations();
+    other_fq->DrainPendingRegistrations();
+
     // compute how much space we will need for the merged data
     size_t otherNeededArraySize = other_fq->UsedCount();
     if (otherNeededArraySize == 0)
@@ -52620,6 +53822,10 @@ bool CFinalize::MergeFinalizationData (CFinalize* other_fq)
         m_Array = newArray;
         m_EndArray = &m_Array [neededArraySize];
     }
+
+    // the free space of both queues changed, so redo the reservation
+    ResetPendingRegistrations();
+    other_fq->ResetPendingRegistrations();
     return true;
 }
 
@@ -52627,6 +53833,9 @@ bool CFinalize::MergeFinalizationData (CFinalize* other_fq)
 // return false in case of failure - in this case, move no items
 bool CFinalize::SplitFinalizationData (CFinalize* other_fq)
 {
+    DrainPendingRegistrations();
+    other_fq->DrainPendingRegistrations();
+
     // the other finalization queue is assumed to be empty at this point
     size_t otherCurrentArraySize = other_fq->UsedCount();
     assert (otherCurrentArraySize == 0);
@@ -52686,12 +53895,19 @@ bool CFinalize::SplitFinalizationData (CFinalize* other_fq)
         m_FillPointers[i] = newFillPointers[i];
     }
 
+    // the free space of both queues changed, so redo the reservation
+    ResetPendingRegistrations();
+    other_fq->ResetPendingRegistrations();
     return true;
 }
 
 #ifdef VERIFY_HEAP
 void CFinalize::CheckFinalizerObjects()
 {
+    // The EE is suspended for verification, so the pending registrations can be
+    // moved into the gen0 segment and verified with the rest.
+    DrainPendingRegistrations();
+
     for (int i = 0; i <= max_generation; i++)
     {
         Object **startIndex = SegQueue (gen_segment (i));
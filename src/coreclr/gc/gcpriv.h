@@ -1296,7 +1296,8 @@ enum msl_take_state
     mt_try_alloc,
     mt_try_budget,
     mt_try_servo_budget,
-    mt_decommit_step
+    mt_decommit_step,
+    mt_commit_ahead
 };
 
 enum msl_enter_state
@@ -1445,6 +1446,7 @@ public:
     size_t get_num_free_regions();
     size_t get_size_committed_in_free() { return size_committed_in_free_regions; }
     size_t get_size_free_regions() { return size_free_regions; }
+    void add_size_committed_in_free (size_t size) { size_committed_in_free_regions += size; }
     heap_segment* get_first_free_region() { return head_free_region; }
     static void unlink_region (heap_segment* region);
     static void add_region (heap_segment* region, region_free_list to_free_list[count_free_region_kinds]);
@@ -1499,6 +1501,38 @@ public:
     void verify_empty();
 };
 
+#ifdef MULTIPLE_HEAPS
+// A bounded Chase-Lev work stealing deque of marked objects whose references
+// still need to be traced. The owning heap pushes and pops at the bottom without
+// interlocked operations (except when racing for the last entry); heaps that
+// ran out of marking work steal from the top with a single CAS.
+class mark_steal_deque
+{
+    static const size_t slot_count = 1024;
+    static const size_t slot_mask = slot_count - 1;
+
+    uint8_t* slot_table[slot_count];
+
+    // top is written by thieves and bottom only by the owner, keep them apart
+    size_t top;
+    uint8_t pad[HS_CACHE_LINE_SIZE - sizeof (size_t)];
+    size_t bottom;
+
+public:
+    void init();
+
+    // returns false if the deque is full, the caller keeps the object then
+    bool push (uint8_t* o);
+    uint8_t* pop();
+    uint8_t* steal();
+
+    bool empty_p()
+    {
+        return (VolatileLoad (&bottom) <= VolatileLoad (&top));
+    }
+};
+#endif //MULTIPLE_HEAPS
+
 float median_of_3 (float a, float b, float c);
 
 //class definition of the internal class
@@ -1707,6 +1741,8 @@ private:
                                     heap_segment* region_to_delete,
                                     heap_segment* prev_region,
                                     heap_segment* next_region);
+    PER_HEAP_ISOLATED_METHOD int get_region_surv_ratio (heap_segment* region);
+    PER_HEAP_METHOD void decide_on_gen2_compact_regions();
     PER_HEAP_METHOD bool should_sweep_in_plan (heap_segment* region);
 
     PER_HEAP_METHOD void sweep_region_in_plan (heap_segment* region,
@@ -1714,6 +1750,19 @@ private:
                                uint8_t**& mark_list_next,
                                uint8_t** mark_list_index);
 
+    PER_HEAP_METHOD void sweep_region_in_plan_objects (heap_segment* region,
+                               BOOL use_mark_list,
+                               uint8_t**& mark_list_next,
+                               uint8_t** mark_list_index);
+
+#ifdef MULTIPLE_HEAPS
+    PER_HEAP_ISOLATED_METHOD bool parallel_sweep_in_plan_p();
+
+    PER_HEAP_METHOD size_t sweep_deferred_regions_of_heap (gc_heap* hp, int condemned_gen_number);
+
+    PER_HEAP_METHOD void sweep_deferred_regions_in_plan (int condemned_gen_number);
+#endif //MULTIPLE_HEAPS
+
     PER_HEAP_METHOD void check_demotion_helper_sip (uint8_t** pval,
                                     int parent_gen_num,
                                     uint8_t* parent_loc);
@@ -2297,6 +2346,10 @@ private:
 
     PER_HEAP_METHOD void bgc_untrack_uoh_alloc();
 
+#ifdef USE_REGIONS
+    PER_HEAP_METHOD void bgc_uoh_sweep_allow_alloc();
+#endif //USE_REGIONS
+
     PER_HEAP_METHOD BOOL bgc_loh_allocate_spin();
 
     PER_HEAP_METHOD BOOL bgc_poh_allocate_spin();
@@ -2438,6 +2491,10 @@ private:
     PER_HEAP_METHOD size_t decommit_ephemeral_segment_pages_step ();
 #endif //MULTIPLE_HEAPS
     PER_HEAP_METHOD size_t decommit_heap_segment_pages_worker (heap_segment* seg, uint8_t *new_committed);
+#ifdef USE_REGIONS
+    PER_HEAP_ISOLATED_METHOD bool region_huge_pages_p (heap_segment* region);
+    PER_HEAP_ISOLATED_METHOD void advise_region_huge_pages (heap_segment* region, uint8_t* start, size_t size);
+#endif //USE_REGIONS
 
 #if !defined(USE_REGIONS) || defined(MULTIPLE_HEAPS)
     PER_HEAP_METHOD uint8_t* get_smoothed_decommit_target (uint8_t* previous_decommit_target,
@@ -2450,11 +2507,22 @@ private:
     PER_HEAP_ISOLATED_METHOD bool decommit_step (uint64_t step_milliseconds);
 #endif //MULTIPLE_HEAPS || USE_REGIONS
 
+#if defined(USE_REGIONS) && defined(MULTIPLE_HEAPS)
+    PER_HEAP_ISOLATED_METHOD bool commit_ahead_step();
+    PER_HEAP_METHOD size_t commit_ahead_free_regions (size_t max_size, bool* more_p);
+    PER_HEAP_METHOD heap_segment* get_commit_ahead_region();
+    PER_HEAP_METHOD void return_commit_ahead_region();
+    PER_HEAP_METHOD size_t commit_ahead_region_pages (heap_segment* region, size_t max_size, bool* commit_failed_p);
+#endif //USE_REGIONS && MULTIPLE_HEAPS
+
 #ifdef USE_REGIONS
     PER_HEAP_ISOLATED_METHOD size_t decommit_region (heap_segment* region, int bucket, int h_number);
 #endif //USE_REGIONS
     PER_HEAP_METHOD void decommit_heap_segment (heap_segment* seg);
     PER_HEAP_ISOLATED_METHOD bool virtual_alloc_commit_for_heap (void* addr, size_t size, int h_number);
+#if defined(USE_REGIONS) && defined(MULTIPLE_HEAPS)
+    PER_HEAP_ISOLATED_METHOD uint16_t numa_node_of_heap_memory (void* addr);
+#endif //USE_REGIONS && MULTIPLE_HEAPS
     PER_HEAP_ISOLATED_METHOD bool virtual_commit (void* address, size_t size, int bucket, int h_number=-1, bool* hard_limit_exceeded_p=NULL);
     PER_HEAP_ISOLATED_METHOD bool virtual_decommit (void* address, size_t size, int bucket, int h_number=-1);
     PER_HEAP_ISOLATED_METHOD void reduce_committed_bytes (void* address, size_t size, int bucket, int h_number, bool decommit_succeeded_p);
@@ -2652,6 +2720,7 @@ private:
 
     PER_HEAP_ISOLATED_METHOD void get_msl_wait_time (size_t* soh_msl_wait_time, size_t* uoh_msl_wait_time);
 
+    PER_HEAP_ISOLATED_METHOD size_t adjust_gen0_budget_for_pause_target (size_t budget_per_heap);
     PER_HEAP_ISOLATED_METHOD void process_datas_sample();
 
     PER_HEAP_METHOD void add_to_hc_history_worker (hc_history* hist, int* current_index, hc_record_stage stage, const char* msg);
@@ -2731,6 +2800,11 @@ private:
     PER_HEAP_METHOD void mark_steal ();
 #endif //MH_SC_MARK
 
+#ifdef MULTIPLE_HEAPS
+    PER_HEAP_METHOD void steal_mark_work();
+    PER_HEAP_METHOD bool mark_steal_offer_p();
+#endif //MULTIPLE_HEAPS
+
 #ifdef BACKGROUND_GC
     PER_HEAP_METHOD BOOL background_marked (uint8_t* o);
     PER_HEAP_METHOD BOOL background_mark1 (uint8_t* o);
@@ -3250,6 +3324,12 @@ private:
                                BOOL concurrent_p, uint8_t*& last_page,
                                uint8_t*& last_object, BOOL large_objects_p,
                                size_t& num_marked_objects);
+    PER_HEAP_METHOD void revisit_written_seg (heap_segment* seg, BOOL concurrent_p, BOOL reset_only_p,
+                                              BOOL small_object_segments, size_t& total_dirtied_pages,
+                                              size_t& total_marked_objects);
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    PER_HEAP_METHOD void revisit_written_regions_parallel (size_t& total_dirtied_pages, size_t& total_marked_objects);
+#endif //MULTIPLE_HEAPS && USE_REGIONS
     PER_HEAP_METHOD void revisit_written_pages (BOOL concurrent_p, BOOL reset_only_p=FALSE);
 
     PER_HEAP_ISOLATED_METHOD void bgc_suspend_EE ();
@@ -3470,6 +3550,18 @@ private:
 
     PER_HEAP_FIELD_SINGLE_GC mark_queue_t mark_queue;
 
+#ifdef MULTIPLE_HEAPS
+    // Objects this heap made available to other heaps while marking, see steal_mark_work.
+    PER_HEAP_FIELD_SINGLE_GC mark_steal_deque mark_deque;
+    // How many objects this heap stole from other heaps during this GC.
+    PER_HEAP_FIELD_SINGLE_GC size_t mark_steal_count;
+    // How many more fanned out objects can use mark_steal_offer_cached_p before
+    // mark_steal_offer_p looks at the shared mark_steal_active_count again.
+    PER_HEAP_FIELD_SINGLE_GC int mark_steal_check_countdown;
+    // Whether some heap was out of marking work when last checked.
+    PER_HEAP_FIELD_SINGLE_GC bool mark_steal_offer_cached_p;
+#endif //MULTIPLE_HEAPS
+
     PER_HEAP_FIELD_SINGLE_GC int gc_policy;  //sweep, compact, expand
 
     PER_HEAP_FIELD_SINGLE_GC size_t total_promoted_bytes;
@@ -3560,6 +3652,14 @@ private:
     PER_HEAP_FIELD_SINGLE_GC uint8_t* background_written_addresses[array_size + 2];
 #endif //WRITE_WATCH
 
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    // Number of gen2 regions of this heap claimed by BGC threads in each of the
+    // concurrent revisit passes, see revisit_written_regions_parallel.
+    PER_HEAP_FIELD_SINGLE_GC VOLATILE(int32_t) bgc_revisit_claimed_count[2];
+    // Which concurrent revisit pass this heap's BGC thread is on.
+    PER_HEAP_FIELD_SINGLE_GC int bgc_revisit_pass;
+#endif //MULTIPLE_HEAPS && USE_REGIONS
+
 #ifdef SNOOP_STATS
     PER_HEAP_FIELD_SINGLE_GC snoop_stats_data snoop_stat;
 #endif //SNOOP_STATS
@@ -3575,8 +3675,22 @@ private:
     PER_HEAP_FIELD_SINGLE_GC int num_regions_freed_in_sweep;
 
     PER_HEAP_FIELD_SINGLE_GC int sip_maxgen_regions_per_gen[max_generation + 1];
+
+    // When a gen2 GC only evacuates a bounded number of gen2 regions, see decide_on_gen2_compact_regions,
+    // gen2 regions with a survival ratio below this are compacted and the rest are swept in plan.
+    PER_HEAP_FIELD_SINGLE_GC bool gen2_compact_bounded_p;
+    PER_HEAP_FIELD_SINGLE_GC int gen2_compact_surv_ratio_th;
+    // How many of the regions right at gen2_compact_surv_ratio_th we can still compact.
+    PER_HEAP_FIELD_SINGLE_GC int gen2_compact_regions_at_th;
     PER_HEAP_FIELD_SINGLE_GC heap_segment* reserved_free_regions_sip[max_generation];
 
+#ifdef MULTIPLE_HEAPS
+    // The SIP regions on this heap whose sweep we deferred till after the plan walk so any GC
+    // thread can sweep them, and how many of those have been claimed by a GC thread.
+    PER_HEAP_FIELD_SINGLE_GC int num_sip_regions_deferred;
+    PER_HEAP_FIELD_SINGLE_GC VOLATILE(int32_t) sip_sweep_claimed_count;
+#endif //MULTIPLE_HEAPS
+
     // Used to keep track of the total regions in each condemned generation. For SIP regions we need
     // to know if we've made all regions in a condemned gen into a max_generation region; if so we
     // would want to revert our decision so we leave at least one region in that generation. Otherwise
@@ -4160,10 +4274,26 @@ private:
 
     // Also updated on the heap#0 GC thread because that's where we are actually doing the decommit.
     PER_HEAP_ISOLATED_FIELD_SINGLE_GC BOOL gradual_decommit_in_progress_p;
+#ifdef USE_REGIONS
+    // Set at the end of a GC and cleared on the heap#0 GC thread once the free regions
+    // we want committed ahead of allocation are all committed.
+    PER_HEAP_ISOLATED_FIELD_SINGLE_GC BOOL commit_ahead_in_progress_p;
+#endif //USE_REGIONS
 #ifdef MH_SC_MARK
     PER_HEAP_ISOLATED_FIELD_SINGLE_GC int* g_mark_stack_busy;
 #endif //MH_SC_MARK
 
+    // Whether heaps share marking work through their mark_deque during this GC.
+    PER_HEAP_ISOLATED_FIELD_SINGLE_GC bool mark_steal_p;
+    // Number of heaps that are still marking (or holding stolen work) - once this
+    // drops to 0 all the mark deques are empty and stealing is done.
+    PER_HEAP_ISOLATED_FIELD_SINGLE_GC VOLATILE(int32_t) mark_steal_active_count;
+
+#ifdef USE_REGIONS
+    // Decided after the plan walk, whether GC threads also sweep the deferred SIP regions of other heaps.
+    PER_HEAP_ISOLATED_FIELD_SINGLE_GC bool sip_sweep_steal_p;
+#endif //USE_REGIONS
+
 #if !defined(USE_REGIONS) || defined(_DEBUG)
     PER_HEAP_ISOLATED_FIELD_SINGLE_GC size_t* g_promoted;
 #endif //!USE_REGIONS || _DEBUG
@@ -4608,6 +4738,87 @@ private:
 
         int get_recorded_tcp_count () { return total_recorded_tcp; }
 
+        //
+        // Pause target mode (GCPauseTargetMs). When it's set we record the pauses of the ephemeral GCs and
+        // use a high percentile of them as an additional input - tcp alone does not tell us how long the
+        // individual pauses are, and a low tcp with few heaps can still mean pauses that are too long.
+        //
+        static const int recorded_pause_array_size = 32;
+        // We use the 90th percentile; with this many entries that's the 4th longest pause.
+        static const int pause_percentile = 90;
+
+        // 0 means we are not in pause target mode.
+        uint64_t        target_pause_us;
+        uint64_t        recorded_pause[recorded_pause_array_size];
+        int             recorded_pause_index;
+        int             total_recorded_pause;
+
+        bool pause_target_p () { return (target_pause_us != 0); }
+
+        void add_to_recorded_pause (uint64_t pause_us)
+        {
+            total_recorded_pause++;
+
+            recorded_pause[recorded_pause_index] = pause_us;
+            recorded_pause_index++;
+            if (recorded_pause_index == recorded_pause_array_size)
+            {
+                recorded_pause_index = 0;
+            }
+        }
+
+        // Since we only ever look at the high end we don't sort the whole array; we just select the
+        // (count - rank) longest pauses which is cheap for such a small array.
+        uint64_t get_pause_percentile ()
+        {
+            int count = min (total_recorded_pause, recorded_pause_array_size);
+            if (count < sample_size)
+            {
+                return 0;
+            }
+
+            uint64_t pauses[recorded_pause_array_size];
+            memcpy (pauses, recorded_pause, (count * sizeof (uint64_t)));
+
+            int rank = (count * pause_percentile + 99) / 100 - 1;
+            int num_to_select = count - rank;
+            for (int i = 0; i < num_to_select; i++)
+            {
+                int max_idx = i;
+                for (int j = i + 1; j < count; j++)
+                {
+                    if (pauses[j] > pauses[max_idx])
+                    {
+                        max_idx = j;
+                    }
+                }
+
+                uint64_t tmp = pauses[i];
+                pauses[i] = pauses[max_idx];
+                pauses[max_idx] = tmp;
+            }
+
+            dprintf (6666, ("p%d of %d recorded pauses is %I64dus (max %I64dus), target %I64dus",
+                pause_percentile, count, pauses[num_to_select - 1], pauses[0], target_pause_us));
+            return pauses[num_to_select - 1];
+        }
+
+        void init_recorded_pause ()
+        {
+            total_recorded_pause = 0;
+            recorded_pause_index = 0;
+        }
+
+        // Returns the heap count we'd need for the recorded pause percentile to be within target, assuming
+        // the pause scales down linearly with the number of heaps (mark and plan are what dominate the
+        // pause and those are split across heaps).
+        int get_hc_for_pause_target (uint64_t pause_us, int current_hc)
+        {
+            assert (pause_target_p());
+            int hc = (int)((pause_us * current_hc + target_pause_us - 1) / target_pause_us);
+            return max (hc, 1);
+        }
+
         float           around_target_accumulation;
         float           around_target_threshold;
 
@@ -5314,11 +5525,32 @@ private:
     // Indicate to use large pages. This only works if hardlimit is also enabled.
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool use_large_pages_p;
 
+#ifdef USE_REGIONS
+    // Init-ed from GCRegionHugePages, the size of a transparent huge page when we advise the OS to
+    // back long lived regions with them, 0 otherwise.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t region_huge_page_size;
+#endif //USE_REGIONS
+
 #ifdef MULTIPLE_HEAPS
     // Init-ed in gc_heap::initialize_gc
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY gc_heap** g_heaps;
 
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool gc_thread_no_affinitize_p;
+
+    // Init-ed from GCMarkSteal, whether heaps may share marking work through their mark_deque.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool enable_mark_steal_p;
+    // Init-ed from GCBGCParallelRevisit, whether BGC threads share the concurrent revisit of gen2 regions.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool enable_bgc_parallel_revisit_p;
+#ifdef USE_REGIONS
+    // Init-ed from GCParallelSweepInPlan, whether SIP regions can be swept by any GC thread.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool enable_parallel_sweep_in_plan_p;
+    // Init-ed from GCCommitAheadRegions, the most free basic regions per heap we commit
+    // between GCs so gen0 doesn't take the commit and page faults. 0 means we don't.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t commit_ahead_max_regions;
+    // Init-ed from GCClearAheadRegions, whether we also clear the dirty part of those regions
+    // so adjust_limit_clr finds them already zeroed.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool clear_ahead_p;
+#endif //USE_REGIONS
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t min_gen0_balance_delta;
 
 #define alloc_quantum_balance_units (16)
@@ -5331,6 +5563,12 @@ private:
 #ifdef BACKGROUND_GC
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool gc_can_use_concurrent;
 
+#ifdef USE_REGIONS
+    // Init-ed from GCBGCUOHSweepPerRegion, whether BGC only blocks UOH allocations while it
+    // sweeps a UOH region instead of for its whole UOH sweep.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool enable_bgc_uoh_sweep_per_region_p;
+#endif //USE_REGIONS
+
 #ifdef BGC_SERVO_TUNING
     // This tells us why we chose to do a bgc in tuning.
     PER_HEAP_ISOLATED_FIELD_DIAG_ONLY int saved_bgc_tuning_reason;
@@ -5341,6 +5579,8 @@ private:
 #ifdef USE_REGIONS
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t regions_range;
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY bool enable_special_regions_p;
+    // Init-ed from GCGen2CompactRegions, 0 means gen2 GCs compact all gen2 regions.
+    PER_HEAP_ISOLATED_FIELD_INIT_ONLY int gen2_compact_region_budget;
 #else //USE_REGIONS
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t eph_gen_starts_size;
     PER_HEAP_ISOLATED_FIELD_INIT_ONLY size_t min_segment_size;
@@ -5572,6 +5812,12 @@ private:
     // Full GC Notification percentages. It's set by the RegisterForFullGCNotification API
     PER_HEAP_FIELD uint32_t fgn_maxgen_percent;
     PER_HEAP_FIELD size_t fgn_last_alloc;
+#if defined(MULTIPLE_HEAPS) && defined(USE_REGIONS)
+    // The free basic region commit_ahead_free_regions took off the free list to clear or commit
+    // without the more space lock. Only changed on the heap#0 GC thread between GCs, or at the
+    // start of a GC which puts it back on the free list.
+    PER_HEAP_FIELD heap_segment* commit_ahead_region;
+#endif //MULTIPLE_HEAPS && USE_REGIONS
     PER_HEAP_ISOLATED_FIELD uint32_t fgn_loh_percent;
     PER_HEAP_ISOLATED_FIELD VOLATILE(bool) full_gc_approach_event_set;
 #ifdef BACKGROUND_GC
@@ -5664,7 +5910,21 @@ private:
     EEThreadId lockowner_threadid;
 #endif // _DEBUG
 
+    // Gen0 registrations are appended here without taking the finalize lock and are
+    // moved into the gen0 segment during the next GC. m_PendingLimit slots of the
+    // free list segment are kept in reserve so that move can never fail.
+    // Everything in the GC that looks at the gen0 segment runs after the move, but
+    // the DAC only sees the fill pointers - until the next GC, up to PendingCapacity
+    // registrations per queue don't show up in SOS's finalize queue.
+    static const int32_t PendingCapacity = 128;
+    Object** m_PendingArray;
+    VOLATILE(int32_t) m_PendingCount;
+    int32_t  m_PendingLimit;
+
     BOOL GrowArray();
+    void InsertItem (Object* obj, unsigned int dest);
+    void DrainPendingRegistrations();
+    void ResetPendingRegistrations();
     void MoveItem (Object** fromIndex,
                    unsigned int fromSeg,
                    unsigned int toSeg);
@@ -6194,6 +6454,12 @@ public:
     //
     // swept_in_plan_p can be folded into gen_num.
     bool            swept_in_plan_p;
+#ifdef MULTIPLE_HEAPS
+    // The NUMA node of the heap that created this region. All of the region's
+    // memory is committed on this node, even after the region is handed to a
+    // heap on another node.
+    uint16_t        numa_node;
+#endif //MULTIPLE_HEAPS
     int             plan_gen_num;
     int             old_card_survived;
     int             pinned_survived;
@@ -6636,6 +6902,13 @@ int& heap_segment_age_in_free (heap_segment* inst)
 {
     return inst->age_in_free;
 }
+#ifdef MULTIPLE_HEAPS
+inline
+uint16_t& heap_segment_numa_node (heap_segment* inst)
+{
+    return inst->numa_node;
+}
+#endif //MULTIPLE_HEAPS
 inline
 size_t& heap_segment_survived (heap_segment* inst)
 {
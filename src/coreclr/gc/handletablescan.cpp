@@ -189,6 +189,16 @@ If you change any of those algorithm, please verify it by this program:
 #define COMPUTE_CLUMP_ADDENDS(gen, msk)     MAKE_CLUMP_MASK_ADDENDS(COMPUTE_CLUMP_MASK(gen, msk))
 #define COMPUTE_AGED_CLUMPS(gen, msk)       APPLY_CLUMP_ADDENDS(gen, COMPUTE_CLUMP_ADDENDS(gen, msk))
 
+#ifdef HOST_64BIT
+// Folding the fill into the age mask means that subtracting the mask is the same as adding
+// (GEN_FILL - age) to each byte, which never carries across bytes. That lets us test the
+// generation dwords of two adjacent blocks at once with a single 64-bit add.
+#define GEN_CLAMP_X2                        (0x3F3F3F3F3F3F3F3FULL)
+#define GEN_MASK_X2                         (0x4040404040404040ULL)
+#define MAKE_AGEMASK_ADDEND_X2(msk)         ((uint64_t)(0U - (uint32_t)(msk)) * 0x0000000100000001ULL)
+#define COMPUTE_CLUMP_MASK_X2(gen, addend)  ((((gen) & GEN_CLAMP_X2) + (addend)) & GEN_MASK_X2)
+#endif // HOST_64BIT
+
 /*--------------------------------------------------------------------------*/
 
 
@@ -692,6 +702,43 @@ void BlockScanBlocksEphemeralWorker(uint32_t *pdwGen, uint32_t dwClumpMask, Scan
 }
 
 
+/*
+ * BlockFindEligibleGeneration
+ *
+ * Returns the first generation dword in [pdwGen, pdwGenLast) that has a clump
+ * eligible under the specified age mask, or pdwGenLast if there is none.
+ *
+ * Most blocks in an ephemeral scan have no eligible clumps at all, so on 64-bit
+ * hosts we check two blocks per iteration and only look at the individual
+ * blocks of a pair that has something to scan.
+ *
+ */
+static inline uint32_t *BlockFindEligibleGeneration(uint32_t *pdwGen, uint32_t *pdwGenLast, uint32_t dwAgeMask)
+{
+    LIMITED_METHOD_CONTRACT;
+
+#ifdef HOST_64BIT
+    uint64_t qwAddend = MAKE_AGEMASK_ADDEND_X2(dwAgeMask);
+
+    while ((pdwGen + 2) <= pdwGenLast)
+    {
+        // the generation bytes of a block start at any dword, so don't assume 8 byte alignment
+        uint64_t qwGen;
+        memcpy(&qwGen, pdwGen, sizeof(qwGen));
+
+        if (COMPUTE_CLUMP_MASK_X2(qwGen, qwAddend))
+            break;
+
+        pdwGen += 2;
+    }
+#endif // HOST_64BIT
+
+    while ((pdwGen < pdwGenLast) && !COMPUTE_CLUMP_MASK(*pdwGen, dwAgeMask))
+        pdwGen++;
+
+    return pdwGen;
+}
+
 /*
  * BlockScanBlocksEphemeral
  *
@@ -710,36 +757,32 @@ void CALLBACK BlockScanBlocksEphemeral(PTR_TableSegment pSegment, uint32_t uBloc
     uint32_t *pdwGen     = (uint32_t *)pSegment->rgGeneration + uBlock;
     uint32_t *pdwGenLast =             pdwGen                 + uCount;
 
-    // loop over all the blocks, checking for eligible clumps as we go
-    do
+    // loop over all the blocks, skipping over the ones with no eligible clumps
+    while ((pdwGen = BlockFindEligibleGeneration(pdwGen, pdwGenLast, dwAgeMask)) < pdwGenLast)
     {
-        // determine if any clumps in this block are eligible
+        // determine which clumps in this block are eligible
         uint32_t dwClumpMask = COMPUTE_CLUMP_MASK(*pdwGen, dwAgeMask);
-
-        // if there are any clumps to scan then scan them now
-        if (dwClumpMask)
-        {
-            // ok we need to scan some parts of this block
-            //
-            // OPTIMIZATION: Since we expect to call the worker fairly rarely compared
-            //  to the number of times we pass through the loop, the function below
-            //  intentionally does not take pSegment as a param.
-            //
-            //  We do this so that the compiler won't try to keep pSegment in a register
-            //  during our loop, leaving more registers for the common codepath.
-            //
-            //  You might wonder why this is an issue considering how few locals we have
-            //  here.  For some reason the x86 compiler doesn't like to use all the
-            //  registers available during this loop and instead was hitting the stack
-            //  repeatedly, so a little coaxing was necessary to get the right output.
-            //
-            BlockScanBlocksEphemeralWorker(pdwGen, dwClumpMask, pInfo);
-        }
+        _ASSERTE(dwClumpMask);
+
+        // ok we need to scan some parts of this block
+        //
+        // OPTIMIZATION: Since we expect to call the worker fairly rarely compared
+        //  to the number of times we pass through the loop, the function below
+        //  intentionally does not take pSegment as a param.
+        //
+        //  We do this so that the compiler won't try to keep pSegment in a register
+        //  during our loop, leaving more registers for the common codepath.
+        //
+        //  You might wonder why this is an issue considering how few locals we have
+        //  here.  For some reason the x86 compiler doesn't like to use all the
+        //  registers available during this loop and instead was hitting the stack
+        //  repeatedly, so a little coaxing was necessary to get the right output.
+        //
+        BlockScanBlocksEphemeralWorker(pdwGen, dwClumpMask, pInfo);
 
         // on to the next block's generation info
         pdwGen++;
-
-    } while (pdwGen < pdwGenLast);
+    }
 
 #ifdef _DEBUG
     // update our scanning statistics
@@ -866,25 +909,21 @@ void CALLBACK BlockResetAgeMapForBlocks(TableSegment *pSegment, uint32_t uBlock,
     uint32_t *pdwGen     = (uint32_t *)pSegment->rgGeneration + uBlock;
     uint32_t *pdwGenLast =             pdwGen                 + uCount;
 
-    // loop over all the blocks, checking for eligible clumps as we go
-    do
+    // loop over all the blocks, skipping over the ones with no eligible clumps
+    while ((pdwGen = BlockFindEligibleGeneration(pdwGen, pdwGenLast, dwAgeMask)) < pdwGenLast)
     {
-        // determine if any clumps in this block are eligible
+        // determine which clumps in this block are eligible
         uint32_t dwClumpMask = COMPUTE_CLUMP_MASK(*pdwGen, dwAgeMask);
+        _ASSERTE(dwClumpMask);
 
-        // if there are any clumps to scan then scan them now
-        if (dwClumpMask)
-        {
-            // ok we need to scan some parts of this block
-            // This code is a variation of the code in BlockScanBlocksEphemeral,
-            // so the OPTIMIZATION comment there applies here as well
-            BlockResetAgeMapForBlocksWorker(pdwGen, dwClumpMask, pInfo);
-        }
+        // ok we need to scan some parts of this block
+        // This code is a variation of the code in BlockScanBlocksEphemeral,
+        // so the OPTIMIZATION comment there applies here as well
+        BlockResetAgeMapForBlocksWorker(pdwGen, dwClumpMask, pInfo);
 
         // on to the next block's generation info
         pdwGen++;
-
-    } while (pdwGen < pdwGenLast);
+    }
 #endif
 }
 
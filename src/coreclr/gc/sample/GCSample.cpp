@@ -13,6 +13,9 @@
 //  * How to implement fast object allocator and write barrier
 //  * How to allocate objects and work with GC handles
 //
+//  Run with -bench it instead allocates a configurable mix of byte arrays and reports GC pause
+//  percentiles and allocation throughput, see RunBenchmark below.
+//
 //  An important part of the sample is the GC environment (gcenv.*) that provides methods for GC to interact
 //  with the OS and execution engine.
 //
@@ -83,6 +86,35 @@ Object * AllocateObject(MethodTable * pMT)
     return pObject;
 }
 
+// Byte arrays use the same layout as the free object: MethodTable*, length and then the bytes.
+Object * AllocateByteArray(MethodTable * pMT, uint32_t length)
+{
+    alloc_context * acontext = GetThread()->GetAllocContext();
+    Object * pObject;
+
+    size_t size = (pMT->GetBaseSize() + length + (sizeof(uintptr_t) - 1)) & ~(sizeof(uintptr_t) - 1);
+
+    uint8_t* result = acontext->alloc_ptr;
+    uint8_t* advance = result + size;
+    if ((size < LARGE_OBJECT_SIZE) && (advance <= acontext->alloc_limit))
+    {
+        acontext->alloc_ptr = advance;
+        pObject = (Object *)result;
+    }
+    else
+    {
+        uint32_t flags = (size >= LARGE_OBJECT_SIZE) ? GC_ALLOC_LARGE_OBJECT_HEAP : 0;
+        pObject = g_theGCHeap->Alloc(acontext, size, flags);
+        if (pObject == NULL)
+            return NULL;
+    }
+
+    pObject->RawSetMethodTable(pMT);
+    *(uint32_t *)((uint8_t *)pObject + ArrayBase::GetOffsetOfNumComponents()) = length;
+
+    return pObject;
+}
+
 #if defined(HOST_64BIT)
 // Card byte shift is different on 64bit.
 #define card_byte_shift     11
@@ -112,6 +144,204 @@ void WriteBarrier(Object ** dst, Object * ref)
     ErectWriteBarrier(dst, ref);
 }
 
+struct BenchmarkOptions
+{
+    uint64_t count;         // number of arrays to allocate
+    uint32_t minSize;       // smallest array length
+    uint32_t maxSize;       // largest array length
+    uint32_t survivePercent;// percentage of arrays kept alive, replacing an older survivor
+    uint32_t pinPercent;    // percentage of survivors kept alive by a pinned handle
+    uint32_t live;          // number of survivors alive at the same time
+};
+
+static bool ParseBenchmarkOptions(int argc, char* argv[], BenchmarkOptions * pOptions)
+{
+    pOptions->count = 10000000;
+    pOptions->minSize = 16;
+    pOptions->maxSize = 256;
+    pOptions->survivePercent = 1;
+    pOptions->pinPercent = 0;
+    pOptions->live = 10000;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if ((i + 1) == argc)
+            return false;
+
+        const char * name = argv[i];
+        uint64_t value = strtoull(argv[++i], NULL, 0);
+
+        if (strcmp(name, "-count") == 0)
+            pOptions->count = value;
+        else if (strcmp(name, "-minsize") == 0)
+            pOptions->minSize = (uint32_t)value;
+        else if (strcmp(name, "-maxsize") == 0)
+            pOptions->maxSize = (uint32_t)value;
+        else if (strcmp(name, "-survive") == 0)
+            pOptions->survivePercent = (uint32_t)value;
+        else if (strcmp(name, "-pin") == 0)
+            pOptions->pinPercent = (uint32_t)value;
+        else if (strcmp(name, "-live") == 0)
+            pOptions->live = (uint32_t)value;
+        else
+            return false;
+    }
+
+    return (pOptions->minSize <= pOptions->maxSize) &&
+           (pOptions->survivePercent <= 100) &&
+           (pOptions->pinPercent <= 100) &&
+           (pOptions->live != 0);
+}
+
+static uint64_t NextRandom(uint64_t * pState)
+{
+    // xorshift64*, good enough to pick sizes and survivors
+    uint64_t x = *pState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *pState = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static double TicksToMilliseconds(int64_t ticks, int64_t frequency)
+{
+    return (double)ticks * 1000.0 / (double)frequency;
+}
+
+//
+// Allocates byte arrays with lengths uniformly distributed in [minsize, maxsize]. Every allocation
+// survives with the given percentage by replacing a random one of the `live` survivors, so that the
+// survivors die at about the same rate as they are created. The given percentage of survivors is
+// held by pinned handles instead of strong ones.
+//
+// The sample environment cannot suspend other threads, so the benchmark is single threaded.
+//
+static int RunBenchmark(IGCHeap * pGCHeap, int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    if (!ParseBenchmarkOptions(argc, argv, &options))
+    {
+        printf("usage: gcsample -bench [-count n] [-minsize bytes] [-maxsize bytes] [-survive percent] [-pin percent] [-live n]\n");
+        return -1;
+    }
+
+    static MethodTable ByteArray_MethodTable;
+    ByteArray_MethodTable.InitializeFreeObject();
+    MethodTable * pByteArrayMethodTable = &ByteArray_MethodTable;
+
+    HHANDLETABLE hTable = g_HandleTableMap.pBuckets[0]->pTable[GetCurrentThreadHomeHeapNumber()];
+    OBJECTHANDLE * pSurvivors = new (nothrow) OBJECTHANDLE[options.live];
+    if (pSurvivors == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i < options.live; i++)
+    {
+        pSurvivors[i] = HndCreateHandle(hTable, HNDTYPE_DEFAULT, NULL);
+        if (pSurvivors[i] == NULL)
+            return -1;
+    }
+
+    // pinned survivors get their own handles so that how many are pinned stays at pinPercent
+    uint32_t livePinned = (uint32_t)(((uint64_t)options.live * options.pinPercent) / 100);
+    OBJECTHANDLE * pPinnedSurvivors = NULL;
+    if (livePinned != 0)
+    {
+        pPinnedSurvivors = new (nothrow) OBJECTHANDLE[livePinned];
+        if (pPinnedSurvivors == NULL)
+            return -1;
+
+        for (uint32_t i = 0; i < livePinned; i++)
+        {
+            pPinnedSurvivors[i] = HndCreateHandle(hTable, HNDTYPE_PINNED, NULL);
+            if (pPinnedSurvivors[i] == NULL)
+                return -1;
+        }
+    }
+
+    int collectionCounts[max_generation + 1];
+    for (int gen = 0; gen <= max_generation; gen++)
+        collectionCounts[gen] = pGCHeap->CollectionCount(gen);
+
+    GCPauseLog::Start(1000000);
+
+    uint64_t random = 0x9E3779B97F4A7C15ULL;
+    uint64_t allocatedBytes = 0;
+    uint32_t sizeRange = options.maxSize - options.minSize + 1;
+    int64_t start = GCToOSInterface::QueryPerformanceCounter();
+
+    for (uint64_t i = 0; i < options.count; i++)
+    {
+        uint64_t r = NextRandom(&random);
+        uint32_t length = options.minSize + (uint32_t)(r % sizeRange);
+
+        Object * p = AllocateByteArray(pByteArrayMethodTable, length);
+        if (p == NULL)
+            return -1;
+
+        allocatedBytes += length;
+
+        r = NextRandom(&random);
+        if ((r % 100) < options.survivePercent)
+        {
+            r = NextRandom(&random);
+            if ((livePinned != 0) && ((r % 100) < options.pinPercent))
+                HndAssignHandle(pPinnedSurvivors[(r >> 8) % livePinned], ObjectToOBJECTREF(p));
+            else
+                HndAssignHandle(pSurvivors[(r >> 8) % options.live], ObjectToOBJECTREF(p));
+        }
+    }
+
+    int64_t elapsed = GCToOSInterface::QueryPerformanceCounter() - start;
+    GCPauseLog::Stop();
+
+    int64_t frequency = GCToOSInterface::QueryPerformanceFrequency();
+    GCPause * pPauses = GCPauseLog::GetPauses();
+    size_t pauseCount = GCPauseLog::GetCount();
+
+    int64_t totalPause = 0;
+    int64_t maxPausePerGen[max_generation + 1] = {};
+    int64_t * pPauseTicks = new (nothrow) int64_t[pauseCount + 1];
+    if (pPauseTicks == NULL)
+        return -1;
+
+    for (size_t i = 0; i < pauseCount; i++)
+    {
+        pPauseTicks[i] = pPauses[i].ticks;
+        totalPause += pPauses[i].ticks;
+        int gen = pPauses[i].condemned;
+        if ((gen >= 0) && (gen <= max_generation))
+            maxPausePerGen[gen] = max(maxPausePerGen[gen], pPauses[i].ticks);
+    }
+    std::sort(pPauseTicks, pPauseTicks + pauseCount);
+
+    double elapsedMs = TicksToMilliseconds(elapsed, frequency);
+    printf("allocated:   %.1f MB in %.1f ms, %.1f MB/s\n",
+        (double)allocatedBytes / (1024 * 1024), elapsedMs, ((double)allocatedBytes / (1024 * 1024)) / (elapsedMs / 1000));
+
+    for (int gen = 0; gen <= max_generation; gen++)
+    {
+        printf("gen%d GCs:    %d, max pause %.3f ms\n",
+            gen, pGCHeap->CollectionCount(gen) - collectionCounts[gen], TicksToMilliseconds(maxPausePerGen[gen], frequency));
+    }
+
+    printf("pauses:      %zu, %.1f ms total, %.1f%% of elapsed\n",
+        pauseCount, TicksToMilliseconds(totalPause, frequency), (elapsedMs != 0) ? (100 * TicksToMilliseconds(totalPause, frequency) / elapsedMs) : 0.0);
+
+    if (pauseCount != 0)
+    {
+        const int percentiles[] = { 50, 90, 99 };
+        for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++)
+        {
+            size_t index = min(pauseCount - 1, (pauseCount * percentiles[i]) / 100);
+            printf("p%d pause:   %.3f ms\n", percentiles[i], TicksToMilliseconds(pPauseTicks[index], frequency));
+        }
+        printf("max pause:   %.3f ms\n", TicksToMilliseconds(pPauseTicks[pauseCount - 1], frequency));
+    }
+
+    return 0;
+}
+
 extern "C" HRESULT LOCALGC_CALLCONV GC_Initialize(IGCToCLR* clrToGC, IGCHeap** gcHeap, IGCHandleManager** gcHandleManager, GcDacVars* gcDacVars);
 
 int __cdecl main(int argc, char* argv[])
@@ -149,6 +379,11 @@ int __cdecl main(int argc, char* argv[])
     //
     ThreadStore::AttachCurrentThread();
 
+    if ((argc > 1) && (strcmp(argv[1], "-bench") == 0))
+    {
+        return RunBenchmark(pGCHeap, argc, argv);
+    }
+
     //
     // Create a Methodtable with GCDesc
     //
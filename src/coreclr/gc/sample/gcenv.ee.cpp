@@ -124,8 +124,39 @@ void ThreadStore::AttachCurrentThread()
     g_pThreadList = pThread;
 }
 
+static GCPause * g_pauses;
+static size_t g_pauseCapacity;
+static size_t g_pauseCount;
+static int64_t g_suspendTimestamp;
+static int g_condemned;
+
+void GCPauseLog::Start(size_t capacity)
+{
+    g_pauses = new (nothrow) GCPause[capacity];
+    g_pauseCapacity = (g_pauses != NULL) ? capacity : 0;
+    g_pauseCount = 0;
+}
+
+void GCPauseLog::Stop()
+{
+    g_pauseCapacity = 0;
+}
+
+GCPause * GCPauseLog::GetPauses()
+{
+    return g_pauses;
+}
+
+size_t GCPauseLog::GetCount()
+{
+    return g_pauseCount;
+}
+
 void GCToEEInterface::SuspendEE(SUSPEND_REASON reason)
 {
+    g_suspendTimestamp = GCToOSInterface::QueryPerformanceCounter();
+    g_condemned = -1;
+
     g_theGCHeap->SetGCInProgress(true);
 
     // TODO: Implement
@@ -136,6 +167,13 @@ void GCToEEInterface::RestartEE(bool bFinishedGC)
     // TODO: Implement
 
     g_theGCHeap->SetGCInProgress(false);
+
+    if (bFinishedGC && (g_pauseCount < g_pauseCapacity))
+    {
+        g_pauses[g_pauseCount].ticks = GCToOSInterface::QueryPerformanceCounter() - g_suspendTimestamp;
+        g_pauses[g_pauseCount].condemned = g_condemned;
+        g_pauseCount++;
+    }
 }
 
 void GCToEEInterface::GcScanRoots(promote_func* fn,  int condemned, int max_gen, ScanContext* sc)
@@ -145,6 +183,7 @@ void GCToEEInterface::GcScanRoots(promote_func* fn,  int condemned, int max_gen,
 
 void GCToEEInterface::GcStartWork(int condemned, int max_gen)
 {
+    g_condemned = condemned;
 }
 
 void GCToEEInterface::BeforeGcScanRoots(int condemned, bool is_bgc, bool is_concurrent)
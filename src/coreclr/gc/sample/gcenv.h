@@ -137,6 +137,26 @@ public:
     static void AttachCurrentThread();
 };
 
+// -----------------------------------------------------------------------------------------------------------
+// Pause recording for the benchmark mode of the sample
+//
+
+struct GCPause
+{
+    int64_t ticks;          // QueryPerformanceCounter ticks between SuspendEE and RestartEE
+    int condemned;          // generation the GC condemned
+};
+
+class GCPauseLog
+{
+public:
+    static void Start(size_t capacity);
+    static void Stop();
+
+    static GCPause * GetPauses();
+    static size_t GetCount();
+};
+
 // -----------------------------------------------------------------------------------------------------------
 // Config file enumulation
 //
@@ -188,20 +188,41 @@ void SoftwareWriteWatch::GetDirty(
 
         while (currentBlock < fullBlockEnd)
         {
-            if (!GetDirtyFromBlock(
-                    currentBlock,
-                    firstPageAddressInCurrentBlock,
-                    0,
-                    sizeof(size_t),
-                    dirtyPages,
-                    &dirtyPageIndex,
-                    dirtyPageCount,
-                    clearDirty))
+            // Skip a clean group of blocks at once. Otherwise go through all of the blocks in the group before checking
+            // the next group, so that each block is only read once by IsBlockGroupClean.
+            uint8_t *groupEnd = fullBlockEnd;
+            if (static_cast<size_t>(fullBlockEnd - currentBlock) >= BlockGroupByteSize)
+            {
+                if (IsBlockGroupClean(currentBlock))
+                {
+                    currentBlock += BlockGroupByteSize;
+                    firstPageAddressInCurrentBlock += BlockGroupByteSize * WRITE_WATCH_UNIT_SIZE;
+                    continue;
+                }
+                groupEnd = currentBlock + BlockGroupByteSize;
+            }
+
+            while (currentBlock < groupEnd)
+            {
+                if (!GetDirtyFromBlock(
+                        currentBlock,
+                        firstPageAddressInCurrentBlock,
+                        0,
+                        sizeof(size_t),
+                        dirtyPages,
+                        &dirtyPageIndex,
+                        dirtyPageCount,
+                        clearDirty))
+                {
+                    break;
+                }
+                currentBlock += sizeof(size_t);
+                firstPageAddressInCurrentBlock += sizeof(size_t) * WRITE_WATCH_UNIT_SIZE;
+            }
+            if (currentBlock < groupEnd)
             {
                 break;
             }
-            currentBlock += sizeof(size_t);
-            firstPageAddressInCurrentBlock += sizeof(size_t) * WRITE_WATCH_UNIT_SIZE;
         }
         if (currentBlock < fullBlockEnd)
         {
@@ -31,6 +31,11 @@ private:
     // GetTable()[address >> AddressToTableByteIndexShift] is the byte that represents the region of memory for 'address'.
     static const uint8_t AddressToTableByteIndexShift = SOFTWARE_WRITE_WATCH_AddressToTableByteIndexShift;
 
+    // GetDirty() looks at the table one size_t-sized block at a time. Only a small part of the heap is usually dirtied
+    // during a background GC, so it first checks a whole group of blocks (one cache line of the table, covering 256 KB of
+    // heap on 64-bit) and skips the group when all of it is clean.
+    static const size_t BlockGroupByteSize = sizeof(size_t) * 8;
+
 private:
     static void VerifyCreated();
     static void VerifyMemoryRegion(void *baseAddress, size_t regionByteSize);
@@ -74,6 +79,7 @@ public:
     static void SetDirty(void *address, size_t writeByteSize);
     static void SetDirtyRegion(void *baseAddress, size_t regionByteSize);
 private:
+    static bool IsBlockGroupClean(uint8_t *blockGroup);
     static bool GetDirtyFromBlock(uint8_t *block, uint8_t *firstPageAddressInBlock, size_t startByteIndex, size_t endByteIndex, void **dirtyPages, size_t *dirtyPageIndexRef, size_t dirtyPageCount, bool clearDirty);
 public:
     static void GetDirty(void *baseAddress, size_t regionByteSize, void **dirtyPages, size_t *dirtyPageCountRef, bool clearDirty, bool isRuntimeSuspended);
@@ -321,6 +327,20 @@ inline void SoftwareWriteWatch::SetDirty(void *address, size_t writeByteSize)
     }
 }
 
+inline bool SoftwareWriteWatch::IsBlockGroupClean(uint8_t *blockGroup)
+{
+    assert(blockGroup != nullptr);
+    assert(ALIGN_DOWN(blockGroup, sizeof(size_t)) == blockGroup);
+
+    size_t *blocks = reinterpret_cast<size_t *>(blockGroup);
+    size_t dirtyBytes = 0;
+    for (size_t i = 0; i < BlockGroupByteSize / sizeof(size_t); ++i)
+    {
+        dirtyBytes |= blocks[i];
+    }
+    return dirtyBytes == 0;
+}
+
 inline void SoftwareWriteWatch::SetDirtyRegion(void *baseAddress, size_t regionByteSize)
 {
     VerifyCreated();
@@ -45,6 +45,7 @@ Abstract:
 #define PROC_STATM_FILENAME "/proc/self/statm"
 #define CGROUP1_MEMORY_LIMIT_FILENAME "/memory.limit_in_bytes"
 #define CGROUP2_MEMORY_LIMIT_FILENAME "/memory.max"
+#define CGROUP2_MEMORY_HIGH_FILENAME "/memory.high"
 #define CGROUP_MEMORY_STAT_FILENAME "/memory.stat"
 #define CGROUP1_MEMORY_USAGE_FILENAME "/memory.usage_in_bytes"
 #define CGROUP2_MEMORY_USAGE_FILENAME "/memory.current"
@@ -77,14 +78,14 @@ public:
         free(s_memory_cgroup_hierarchy_mount);
     }
 
-    static bool GetPhysicalMemoryLimit(uint64_t *val)
+    static bool GetPhysicalMemoryLimit(uint64_t *val, bool considerMemoryHigh)
     {
         if (s_cgroup_version == 0)
             return false;
         else if (s_cgroup_version == 1)
             return GetCGroupMemoryLimitV1(val);
         else if (s_cgroup_version == 2)
-            return GetCGroupMemoryLimitV2(val);
+            return GetCGroupMemoryLimitV2(val, considerMemoryHigh);
         else
         {
             assert(!"Unknown cgroup version.");
@@ -453,7 +454,26 @@ private:
         return result;
     }
     
-    static bool GetCGroupMemoryLimitV2(uint64_t *val)
+    static bool GetCGroupMemoryLimitV2(uint64_t *val, bool considerMemoryHigh)
+    {
+        bool found_any_limit = GetCGroupMemoryValueV2(CGROUP2_MEMORY_LIMIT_FILENAME, val);
+
+        // Exceeding memory.high doesn't cause OOM kills, but the kernel throttles the cgroup and reclaims its memory
+        // aggressively. When requested, treat it as the limit so that the GC reacts before the throttling starts.
+        uint64_t high;
+        if (considerMemoryHigh && GetCGroupMemoryValueV2(CGROUP2_MEMORY_HIGH_FILENAME, &high))
+        {
+            if (!found_any_limit || (high < *val))
+            {
+                *val = high;
+            }
+            found_any_limit = true;
+        }
+
+        return found_any_limit;
+    }
+
+    static bool GetCGroupMemoryValueV2(const char *filename, uint64_t *val)
     {
         if (s_memory_cgroup_path == nullptr)
             return false;
@@ -465,13 +485,13 @@ private:
         bool found_any_limit = false;
 
         char *mem_limit_filename = nullptr;
-        if (asprintf(&mem_limit_filename, "%s%s", s_memory_cgroup_path, CGROUP2_MEMORY_LIMIT_FILENAME) < 0)
+        if (asprintf(&mem_limit_filename, "%s%s", s_memory_cgroup_path, filename) < 0)
             return false;
 
         size_t cgroupPathLength = strlen(s_memory_cgroup_path);
 
         // Iterate over the directory hierarchy representing the cgroup hierarchy until reaching the 
-        // mount directory. The mount directory doesn't contain the memory.max.
+        // mount directory. The mount directory doesn't contain the memory.max or memory.high.
         do
         {
             if (ReadMemoryValueFromFile(mem_limit_filename, &limit))
@@ -492,7 +512,7 @@ private:
 
             cgroupPathLength = parent_directory_end - mem_limit_filename;
 
-            strcpy(parent_directory_end, CGROUP2_MEMORY_LIMIT_FILENAME);
+            strcpy(parent_directory_end, filename);
         }
         while (cgroupPathLength != memory_cgroup_hierarchy_mount_length);
 
@@ -565,11 +585,11 @@ void CleanupCGroup()
     CGroup::Cleanup();
 }
 
-size_t GetRestrictedPhysicalMemoryLimit()
+size_t GetRestrictedPhysicalMemoryLimit(bool considerMemoryHigh)
 {
     uint64_t physical_memory_limit = 0;
 
-    if (!CGroup::GetPhysicalMemoryLimit(&physical_memory_limit))
+    if (!CGroup::GetPhysicalMemoryLimit(&physical_memory_limit, considerMemoryHigh))
          return 0;
 
     // If there's no memory limit specified on the container this
@@ -209,7 +209,7 @@ static uint8_t* g_helperPage = 0;
 // Mutex to make the FlushProcessWriteBuffersMutex thread safe
 static pthread_mutex_t g_flushProcessWriteBuffersMutex;
 
-size_t GetRestrictedPhysicalMemoryLimit();
+size_t GetRestrictedPhysicalMemoryLimit(bool considerMemoryHigh);
 bool GetPhysicalMemoryUsed(size_t* val);
 
 static size_t g_RestrictedPhysicalMemoryLimit = 0;
@@ -866,6 +866,60 @@ done:
     return result;
 }
 
+// Get the size of a transparent huge page.
+// Return:
+//  Size of a transparent huge page, or 0 if the OS does not support transparent huge pages
+//  or they are disabled.
+size_t GCToOSInterface::GetTransparentHugePageSize()
+{
+    size_t hugePageSize = 0;
+
+#if defined(TARGET_LINUX) && defined(MADV_HUGEPAGE)
+    // The enabled file looks like "always [madvise] never" with the current mode in brackets.
+    // madvise(MADV_HUGEPAGE) has no effect when the mode is never.
+    bool enabled = false;
+    FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (file != nullptr)
+    {
+        char* line = nullptr;
+        size_t lineLen = 0;
+        if (getline(&line, &lineLen, file) != -1)
+        {
+            enabled = (strstr(line, "[never]") == nullptr);
+        }
+
+        free(line);
+        fclose(file);
+    }
+
+    uint64_t pmdSize = 0;
+    if (enabled &&
+        ReadMemoryValueFromFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", &pmdSize) &&
+        (pmdSize > OS_PAGE_SIZE) && ((pmdSize & (pmdSize - 1)) == 0))
+    {
+        hugePageSize = (size_t)pmdSize;
+    }
+#endif // TARGET_LINUX && MADV_HUGEPAGE
+
+    return hugePageSize;
+}
+
+// Advise the OS whether a virtual memory range should be backed by transparent huge pages.
+// Parameters:
+//  address   - starting virtual address
+//  size      - size of the virtual memory range
+//  hugePages - true to ask for huge pages, false to ask for the range to never use them
+// Return:
+//  true if it has succeeded, false if it has failed
+bool GCToOSInterface::VirtualAdviseHugePages(void* address, size_t size, bool hugePages)
+{
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+    return (madvise(address, size, (hugePages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE)) == 0);
+#else
+    return false;
+#endif // MADV_HUGEPAGE && MADV_NOHUGEPAGE
+}
+
 static void GetLogicalProcessorCacheSizeFromSysConf(size_t* cacheLevel, size_t* cacheSize)
 {
     assert (cacheLevel != nullptr);
@@ -1255,7 +1309,7 @@ uint64_t GCToOSInterface::GetPhysicalMemoryLimit(bool* is_restricted)
     if (is_restricted)
         *is_restricted = false;
 
-    restricted_limit = GetRestrictedPhysicalMemoryLimit();
+    restricted_limit = GetRestrictedPhysicalMemoryLimit(GCConfig::GetGCCgroupMemoryHigh());
     VolatileStore(&g_RestrictedPhysicalMemoryLimit, restricted_limit);
 
     if (restricted_limit != 0 && restricted_limit != SIZE_T_MAX)
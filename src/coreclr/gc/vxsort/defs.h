@@ -13,6 +13,7 @@
 #endif
 #ifdef _M_ARM64
 #define ARCH_ARM
+#define ARCH_ARM64
 #endif
 #else
 #ifdef __i386__
@@ -24,6 +25,10 @@
 #ifdef __arm__
 #define ARCH_ARM
 #endif
+#ifdef __aarch64__
+#define ARCH_ARM
+#define ARCH_ARM64
+#endif
 #endif
 
 #ifdef _MSC_VER
@@ -45,6 +50,21 @@
 #define NOINLINE __attribute__((noinline))
 #endif
 
+// Population count of the comparison masks produced by the machine traits;
+// x64 relies on the popcnt target being enabled by vxsort.h
+#if defined(ARCH_X64)
+#define vxsort_popcnt_u32(x) _mm_popcnt_u32(x)
+#define vxsort_popcnt_u64(x) _mm_popcnt_u64(x)
+#elif defined(ARCH_ARM64)
+#ifdef _MSC_VER
+#define vxsort_popcnt_u32(x) ((int)_CountOneBits(x))
+#define vxsort_popcnt_u64(x) ((int64_t)_CountOneBits64(x))
+#else
+#define vxsort_popcnt_u32(x) __builtin_popcount(x)
+#define vxsort_popcnt_u64(x) ((int64_t)__builtin_popcountll(x))
+#endif
+#endif
+
 using std::max;
 using std::min;
 #endif  // VXSORT_DEFS_H
@@ -6,6 +6,7 @@ enum class InstructionSet
 {
     AVX2 = 0,
     AVX512F = 1,
+    NEON = 2,
 };
 
 void InitSupportedInstructionSet (int32_t configSetting);
@@ -14,3 +15,12 @@ bool IsSupportedInstructionSet (InstructionSet instructionSet);
 void do_vxsort_avx2 (uint8_t** low, uint8_t** high, uint8_t *range_low, uint8_t *range_high);
 
 void do_vxsort_avx512 (uint8_t** low, uint8_t** high, uint8_t* range_low, uint8_t* range_high);
+
+void do_vxsort_neon (uint8_t** low, uint8_t** high, uint8_t* range_low, uint8_t* range_high);
+
+// Returns the first non-zero word in [word, word_end), or word_end if they are all zero.
+uint32_t* find_nonzero_word_avx2 (uint32_t* word, uint32_t* word_end);
+
+uint32_t* find_nonzero_word_avx512 (uint32_t* word, uint32_t* word_end);
+
+uint32_t* find_nonzero_word_neon (uint32_t* word, uint32_t* word_end);
@@ -28,3 +28,26 @@ void do_vxsort_avx512 (uint8_t** low, uint8_t** high, uint8_t* range_low, uint8_
 {
     assert(false);
 }
+
+void do_vxsort_neon (uint8_t** low, uint8_t** high, uint8_t* range_low, uint8_t* range_high)
+{
+    assert(false);
+}
+
+uint32_t* find_nonzero_word_avx2 (uint32_t* word, uint32_t* word_end)
+{
+    assert(false);
+    return word_end;
+}
+
+uint32_t* find_nonzero_word_avx512 (uint32_t* word, uint32_t* word_end)
+{
+    assert(false);
+    return word_end;
+}
+
+uint32_t* find_nonzero_word_neon (uint32_t* word, uint32_t* word_end)
+{
+    assert(false);
+    return word_end;
+}
@@ -0,0 +1,36 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+#include "common.h"
+
+#include "vxsort_targets_enable_avx2.h"
+
+#include <immintrin.h>
+#include "do_vxsort.h"
+
+// Skips 512 bits (2 AVX2 vectors) of zero words at a time; the word that
+// stopped us is then found with the scalar loop.
+uint32_t* find_nonzero_word_avx2 (uint32_t* word, uint32_t* word_end)
+{
+    const ptrdiff_t words_per_iteration = 2 * sizeof(__m256i) / sizeof(uint32_t);
+
+    while ((word_end - word) >= words_per_iteration)
+    {
+        __m256i v0 = _mm256_loadu_si256 ((const __m256i*)word);
+        __m256i v1 = _mm256_loadu_si256 ((const __m256i*)(word + words_per_iteration / 2));
+        __m256i v = _mm256_or_si256 (v0, v1);
+        if (!_mm256_testz_si256 (v, v))
+        {
+            break;
+        }
+        word += words_per_iteration;
+    }
+
+    while ((word < word_end) && !(*word))
+    {
+        word++;
+    }
+
+    return word;
+}
+#include "vxsort_targets_disable.h"
@@ -0,0 +1,34 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+#include "common.h"
+
+#include "vxsort_targets_enable_avx512.h"
+
+#include <immintrin.h>
+#include "do_vxsort.h"
+
+// Skips 512 bits of zero words at a time; the word that stopped us is then
+// found with the scalar loop.
+uint32_t* find_nonzero_word_avx512 (uint32_t* word, uint32_t* word_end)
+{
+    const ptrdiff_t words_per_iteration = sizeof(__m512i) / sizeof(uint32_t);
+
+    while ((word_end - word) >= words_per_iteration)
+    {
+        __m512i v = _mm512_loadu_si512 ((const void*)word);
+        if (_mm512_test_epi32_mask (v, v))
+        {
+            break;
+        }
+        word += words_per_iteration;
+    }
+
+    while ((word < word_end) && !(*word))
+    {
+        word++;
+    }
+
+    return word;
+}
+#include "vxsort_targets_disable.h"
@@ -0,0 +1,35 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+#include "common.h"
+
+#include <arm_neon.h>
+#include "do_vxsort.h"
+
+// Skips 512 bits (4 AdvSIMD vectors) of zero words at a time; the word that
+// stopped us is then found with the scalar loop.
+uint32_t* find_nonzero_word_neon (uint32_t* word, uint32_t* word_end)
+{
+    const ptrdiff_t words_per_iteration = 4 * sizeof(uint32x4_t) / sizeof(uint32_t);
+
+    while ((word_end - word) >= words_per_iteration)
+    {
+        uint32x4_t v0 = vld1q_u32 (word);
+        uint32x4_t v1 = vld1q_u32 (word + 4);
+        uint32x4_t v2 = vld1q_u32 (word + 8);
+        uint32x4_t v3 = vld1q_u32 (word + 12);
+        uint32x4_t v = vorrq_u32 (vorrq_u32 (v0, v1), vorrq_u32 (v2, v3));
+        if (vmaxvq_u32 (v) != 0)
+        {
+            break;
+        }
+        word += words_per_iteration;
+    }
+
+    while ((word < word_end) && !(*word))
+    {
+        word++;
+    }
+
+    return word;
+}
@@ -8,7 +8,9 @@
 #include "alignment.h"
 #include "machine_traits.h"
 
+#if defined(ARCH_X64)
 #include <immintrin.h>
+#endif // ARCH_X64
 
 namespace vxsort {
 
@@ -0,0 +1,43 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+#ifndef INSERTION_SORT_NEON_H
+#define INSERTION_SORT_NEON_H
+
+#include "bitonic_sort.h"
+
+namespace vxsort {
+namespace smallsort {
+
+// AdvSIMD has neither 64-bit min/max nor the wide cross-lane shuffles the
+// generated AVX2/AVX512 bitonic networks are built from, and with only 2-4
+// lanes per vector a network over MAX_BITONIC_SORT_VECTORS registers does not
+// beat a straight insertion sort of the same (<= 64 element) partitions.
+template <typename T>
+struct neon_insertion_sort {
+    static INLINE void sort(T* ptr, size_t length) {
+        for (size_t i = 1; i < length; i++) {
+            T v = ptr[i];
+            size_t j = i;
+            while ((j > 0) && (ptr[j - 1] > v)) {
+                ptr[j] = ptr[j - 1];
+                j--;
+            }
+            ptr[j] = v;
+        }
+    }
+};
+
+template<> struct bitonic<int64_t, NEON> {
+public:
+    static NOINLINE void sort(int64_t* ptr, size_t length) { neon_insertion_sort<int64_t>::sort(ptr, length); }
+};
+
+template<> struct bitonic<int32_t, NEON> {
+public:
+    static NOINLINE void sort(int32_t* ptr, size_t length) { neon_insertion_sort<int32_t>::sort(ptr, length); }
+};
+
+}  // namespace smallsort
+}  // namespace vxsort
+#endif
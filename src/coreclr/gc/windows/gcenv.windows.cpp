@@ -794,6 +794,31 @@ bool GCToOSInterface::VirtualReset(void * address, size_t size, bool unlock)
     return success;
 }
 
+// Get the size of a transparent huge page.
+// Return:
+//  Size of a transparent huge page, or 0 if the OS does not support transparent huge pages
+//  or they are disabled.
+size_t GCToOSInterface::GetTransparentHugePageSize()
+{
+    // Windows only supports explicit large pages, see VirtualReserveAndCommitLargePages.
+    return 0;
+}
+
+// Advise the OS whether a virtual memory range should be backed by transparent huge pages.
+// Parameters:
+//  address   - starting virtual address
+//  size      - size of the virtual memory range
+//  hugePages - true to ask for huge pages, false to ask for the range to never use them
+// Return:
+//  true if it has succeeded, false if it has failed
+bool GCToOSInterface::VirtualAdviseHugePages(void* address, size_t size, bool hugePages)
+{
+    UNREFERENCED_PARAMETER(address);
+    UNREFERENCED_PARAMETER(size);
+    UNREFERENCED_PARAMETER(hugePages);
+    return false;
+}
+
 // Check if the OS supports write watching
 bool GCToOSInterface::SupportsWriteWatch()
 {
@@ -597,6 +597,7 @@ RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_BackpatchEntryPointSlots, W("BackpatchEntry
 /// TypeLoader
 ///
 CONFIG_DWORD_INFO(INTERNAL_TypeLoader_InjectInterfaceDuplicates, W("INTERNAL_TypeLoader_InjectInterfaceDuplicates"), 0, "Injects duplicates in interface map for all types.")
+RETAIL_CONFIG_DWORD_INFO(EXTERNAL_CastCacheMaxSize, W("CastCacheMaxSize"), 0, "Maximum number of entries the cast cache may grow to, rounded up to a power of two. 0 uses the default.")
 
 ///
 /// Virtual call stubs
@@ -41,10 +41,16 @@ private:
         GenTree*    node  = nullptr;
     };
 
+    // Max number of stores allowed in the Then case when there is no Else case.
+    static const int MaxThenStores = 3;
+
     GenTree*           m_cond;          // The condition in the conversion
-    IfConvertOperation m_thenOperation; // The single operation in the Then case.
+    IfConvertOperation m_thenOperation; // The first (usually single) operation in the Then case.
     IfConvertOperation m_elseOperation; // The single operation in the Else case.
 
+    IfConvertOperation m_extraThenStores[MaxThenStores - 1]; // Further stores in the Then case.
+    int                m_extraThenStoreCount = 0;
+
     int m_checkLimit = 4; // Max number of chained blocks to allow in both the True and Else cases.
 
     genTreeOps m_mainOper         = GT_COUNT; // The main oper of the if conversion.
@@ -54,7 +60,8 @@ private:
     bool IfConvertCheckInnerBlockFlow(BasicBlock* block);
     bool IfConvertCheckThenFlow();
     void IfConvertFindFlow();
-    bool IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOperation* foundOperation);
+    bool IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOperation* foundOperation, bool allowMultipleStores);
+    bool IfConvertCheckMultipleStores();
     void IfConvertJoinStmts(BasicBlock* fromBlock);
 
 #ifdef DEBUG
@@ -209,17 +216,21 @@ void OptIfConversionDsc::IfConvertFindFlow()
 //
 // From the given block to the final block, check all the statements and nodes are
 // valid for an If conversion. Chain of blocks must contain only a single local
-// store and no other operations.
+// store and no other operations, unless multiple stores are allowed, in which case
+// up to MaxThenStores local stores may be present.
 //
 // Arguments:
-//   fromBlock      - Block inside the if statement to start from (Either Then or Else path).
-//   foundOperation - Returns the found operation.
+//   fromBlock           - Block inside the if statement to start from (Either Then or Else path).
+//   foundOperation      - Returns the found operation.
+//   allowMultipleStores - Whether further stores may be recorded in m_extraThenStores.
 //
 // Returns:
-//   If everything is valid, then set foundOperation to the store and return true.
+//   If everything is valid, then set foundOperation to the first store and return true.
 //   Otherwise return false.
 //
-bool OptIfConversionDsc::IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOperation* foundOperation)
+bool OptIfConversionDsc::IfConvertCheckStmts(BasicBlock*         fromBlock,
+                                             IfConvertOperation* foundOperation,
+                                             bool                allowMultipleStores)
 {
     bool found = false;
 
@@ -235,8 +246,9 @@ bool OptIfConversionDsc::IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOpe
             {
                 case GT_STORE_LCL_VAR:
                 {
-                    // Only one per operation per block can be conditionally executed.
-                    if (found)
+                    // Only one per operation per block can be conditionally executed,
+                    // unless we are allowed to collect a few more stores.
+                    if (found && (!allowMultipleStores || (m_extraThenStoreCount == (MaxThenStores - 1))))
                     {
                         return false;
                     }
@@ -278,6 +290,15 @@ bool OptIfConversionDsc::IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOpe
                         return false;
                     }
 
+                    if (found)
+                    {
+                        IfConvertOperation* const extraStore = &m_extraThenStores[m_extraThenStoreCount++];
+                        extraStore->block                    = block;
+                        extraStore->stmt                     = stmt;
+                        extraStore->node                     = tree;
+                        break;
+                    }
+
                     found                 = true;
                     foundOperation->block = block;
                     foundOperation->stmt  = stmt;
@@ -353,6 +374,55 @@ bool OptIfConversionDsc::IfConvertCheckStmts(BasicBlock* fromBlock, IfConvertOpe
     return found;
 }
 
+//-----------------------------------------------------------------------------
+// IfConvertCheckMultipleStores
+//
+// Check that a Then case with several stores can be converted into one SELECT
+// per store. Each SELECT re-evaluates a copy of the condition after the earlier
+// stores have been done, so the condition must be cheap to duplicate and must not
+// read any of the stored locals.
+//
+// Returns:
+//   True if the stores can be converted, else false.
+//
+bool OptIfConversionDsc::IfConvertCheckMultipleStores()
+{
+    assert(m_extraThenStoreCount > 0);
+    assert(!m_doElseConversion);
+
+    GenTree* const operands[] = {m_cond->gtGetOp1(), m_cond->gtGetOp2()};
+
+    for (GenTree* const operand : operands)
+    {
+        if (operand->IsInvariant())
+        {
+            continue;
+        }
+
+        if (!operand->OperIs(GT_LCL_VAR))
+        {
+            JITDUMP("Condition is not simple enough to duplicate for multiple stores\n");
+            return false;
+        }
+
+        const unsigned lclNum   = operand->AsLclVar()->GetLclNum();
+        bool           isStored = (m_thenOperation.node->AsLclVar()->GetLclNum() == lclNum);
+
+        for (int i = 0; !isStored && (i < m_extraThenStoreCount); i++)
+        {
+            isStored = (m_extraThenStores[i].node->AsLclVar()->GetLclNum() == lclNum);
+        }
+
+        if (isStored)
+        {
+            JITDUMP("Condition reads V%02u which is stored to under it\n", lclNum);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // IfConvertJoinStmts
 //
@@ -572,15 +642,20 @@ bool OptIfConversionDsc::optIfConvert()
         return false;
     }
 
-    // Check the Then and Else blocks have a single operation each.
-    if (!IfConvertCheckStmts(m_startBlock->GetFalseTarget(), &m_thenOperation))
+    // Check the Then and Else blocks have a single operation each. Without an Else
+    // case, the Then case may also consist of a few stores.
+    if (!IfConvertCheckStmts(m_startBlock->GetFalseTarget(), &m_thenOperation, !m_doElseConversion))
     {
         return false;
     }
     assert(m_thenOperation.node->OperIs(GT_STORE_LCL_VAR, GT_RETURN));
+    if ((m_extraThenStoreCount > 0) && !IfConvertCheckMultipleStores())
+    {
+        return false;
+    }
     if (m_doElseConversion)
     {
-        if (!IfConvertCheckStmts(m_startBlock->GetTrueTarget(), &m_elseOperation))
+        if (!IfConvertCheckStmts(m_startBlock->GetTrueTarget(), &m_elseOperation, false))
         {
             return false;
         }
@@ -643,6 +718,13 @@ bool OptIfConversionDsc::optIfConvert()
             }
         }
 
+        // All the stores of the Then case are evaluated unconditionally, so they share the budget.
+        for (int i = 0; i < m_extraThenStoreCount; i++)
+        {
+            GenTree* const store = m_extraThenStores[i].node;
+            thenCost += store->AsLclVar()->Data()->GetCostEx() + (m_comp->gtIsLikelyRegVar(store) ? 0 : 2);
+        }
+
         // Cost to allow for "x = cond ? a + b : c + d".
         if (thenCost > 7 || elseCost > 7)
         {
@@ -650,6 +732,19 @@ bool OptIfConversionDsc::optIfConvert()
                     elseCost);
             return false;
         }
+
+        // Converting several stores trades a branch for a chain of conditional moves,
+        // which only pays off if the branch is hard to predict.
+        if ((m_extraThenStoreCount > 0) && m_startBlock->hasProfileWeight())
+        {
+            const weight_t thenLikelihood = m_startBlock->GetFalseEdge()->getLikelihood();
+            if ((thenLikelihood < 0.2) || (thenLikelihood > 0.8))
+            {
+                JITDUMP("Skipping if-conversion of %d stores under a well predicted branch (likelihood %g)\n",
+                        m_extraThenStoreCount + 1, thenLikelihood);
+                return false;
+            }
+        }
     }
 
     if (!m_comp->compStressCompile(Compiler::STRESS_IF_CONVERSION_INNER_LOOPS, 25))
@@ -721,6 +816,20 @@ bool OptIfConversionDsc::optIfConvert()
     m_comp->gtSetEvalOrder(m_thenOperation.node);
     m_comp->fgSetStmtSeq(m_thenOperation.stmt);
 
+    // Each further store gets its own SELECT on a copy of the condition.
+    for (int i = 0; i < m_extraThenStoreCount; i++)
+    {
+        GenTreeLclVar* const store = m_extraThenStores[i].node->AsLclVar();
+        GenTree* const       cond  = m_comp->gtCloneExpr(m_cond);
+        GenTreeConditional*  extraSelect =
+            m_comp->gtNewConditionalNode(GT_SELECT, cond, m_comp->gtNewLclVarNode(store->GetLclNum(), store->TypeGet()),
+                                         store->Data(), genActualType(store));
+        store->AddAllEffectsFlags(extraSelect);
+        store->Data() = extraSelect;
+        m_comp->gtSetEvalOrder(store);
+        m_comp->fgSetStmtSeq(m_extraThenStores[i].stmt);
+    }
+
     // Remove statements.
     last->gtBashToNOP();
     m_comp->gtSetEvalOrder(last);
@@ -734,6 +843,15 @@ bool OptIfConversionDsc::optIfConvert()
 
     // Merge all the blocks.
     IfConvertJoinStmts(m_thenOperation.block);
+    BasicBlock* lastJoinedBlock = m_thenOperation.block;
+    for (int i = 0; i < m_extraThenStoreCount; i++)
+    {
+        if (m_extraThenStores[i].block != lastJoinedBlock)
+        {
+            lastJoinedBlock = m_extraThenStores[i].block;
+            IfConvertJoinStmts(lastJoinedBlock);
+        }
+    }
     if (m_doElseConversion)
     {
         IfConvertJoinStmts(m_elseOperation.block);
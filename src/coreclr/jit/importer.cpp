@@ -3814,24 +3814,107 @@ GenTree* Compiler::impImportStaticReadOnlyField(CORINFO_FIELD_HANDLE field, CORI
                 }
 #endif // FEATURE_SIMD
 
+                bool isAllZero = true;
                 for (unsigned i = 0; i < totalSize; i++)
                 {
                     if (buffer[i] != 0)
                     {
-                        // Value is not all zeroes - bail out.
-                        // Although, We might eventually support that too.
-                        JITDUMP("value is not all zeros - bail out.");
+                        isAllZero = false;
+                        break;
+                    }
+                }
+
+                if (isAllZero)
+                {
+                    JITDUMP("Success! Optimizing to STORE_LCL_VAR<struct>(0).");
+                    unsigned structTempNum = lvaGrabTemp(true DEBUGARG("folding static readonly field empty struct"));
+                    lvaSetStruct(structTempNum, fieldClsHnd, false);
+
+                    impStoreToTemp(structTempNum, gtNewIconNode(0), CHECK_SPILL_NONE);
+
+                    return gtNewLclVarNode(structTempNum);
+                }
+
+                // Structs made of a few primitive fields are folded field by field, using the
+                // struct's own field layout so that promotion is not pessimized.
+                const unsigned MaxFoldedFields = 4;
+                if ((fieldsCnt == 0) || (fieldsCnt > MaxFoldedFields))
+                {
+                    JITDUMP("value is not all zeros and struct has too many fields - bail out.");
+                    return nullptr;
+                }
+
+                // Inline arrays and overlapping fields hold data that their declared fields don't describe.
+                const DWORD structAttribs = info.compCompHnd->getClassAttribs(fieldClsHnd);
+                if (StructHasIndexableFields(structAttribs) || StructHasOverlappingFields(structAttribs))
+                {
+                    JITDUMP("struct has indexable or overlapping fields - bail out.");
+                    return nullptr;
+                }
+
+                static_assert_no_msg(MaxStructSize <= 64);
+                var_types innerFieldTypes[MaxFoldedFields];
+                unsigned  innerFieldOffsets[MaxFoldedFields];
+                uint64_t  coveredBytes = 0;
+                for (unsigned i = 0; i < fieldsCnt; i++)
+                {
+                    CORINFO_FIELD_HANDLE innerField = info.compCompHnd->getFieldInClass(fieldClsHnd, i);
+                    CORINFO_CLASS_HANDLE innerFieldClsHnd;
+                    innerFieldTypes[i] =
+                        JITtype2varType(info.compCompHnd->getFieldType(innerField, &innerFieldClsHnd, fieldClsHnd));
+                    innerFieldOffsets[i] = info.compCompHnd->getFieldOffset(innerField);
+
+                    if (!varTypeIsIntegral(innerFieldTypes[i]) && !varTypeIsFloating(innerFieldTypes[i]))
+                    {
+                        JITDUMP("struct has non-primitive fields - bail out.");
+                        return nullptr;
+                    }
+
+                    if ((innerFieldOffsets[i] + genTypeSize(innerFieldTypes[i])) > totalSize)
+                    {
+                        JITDUMP("struct has complex layout - bail out.");
+                        return nullptr;
+                    }
+
+                    for (unsigned j = 0; j < genTypeSize(innerFieldTypes[i]); j++)
+                    {
+                        coveredBytes |= (uint64_t)1 << (innerFieldOffsets[i] + j);
+                    }
+                }
+
+                // Every non-zero byte has to be stored by one of the fields below.
+                for (unsigned i = 0; i < totalSize; i++)
+                {
+                    if ((buffer[i] != 0) && ((coveredBytes & ((uint64_t)1 << i)) == 0))
+                    {
+                        JITDUMP("struct has non-zero data outside of its fields - bail out.");
                         return nullptr;
                     }
                 }
 
-                JITDUMP("Success! Optimizing to STORE_LCL_VAR<struct>(0).");
-                unsigned structTempNum = lvaGrabTemp(true DEBUGARG("folding static readonly field empty struct"));
+                JITDUMP("Success! Optimizing to per-field STORE_LCL_FLD(CNS) nodes.");
+                unsigned structTempNum = lvaGrabTemp(true DEBUGARG("folding static readonly field struct"));
                 lvaSetStruct(structTempNum, fieldClsHnd, false);
 
                 impStoreToTemp(structTempNum, gtNewIconNode(0), CHECK_SPILL_NONE);
 
-                return gtNewLclVarNode(structTempNum);
+                for (unsigned i = 0; i < fieldsCnt; i++)
+                {
+                    GenTree* constValTree = gtNewGenericCon(innerFieldTypes[i], buffer + innerFieldOffsets[i]);
+                    assert(constValTree != nullptr);
+
+                    if (constValTree->IsIntegralConst(0) || constValTree->IsFloatPositiveZero())
+                    {
+                        // Already covered by the zero init above.
+                        continue;
+                    }
+
+                    GenTree* fieldStoreTree =
+                        gtNewStoreLclFldNode(structTempNum, innerFieldTypes[i], innerFieldOffsets[i], constValTree);
+                    impAppendTree(fieldStoreTree, CHECK_SPILL_NONE, impCurStmtDI);
+                }
+
+                return impCreateLocalNode(structTempNum DEBUGARG(0));
             }
 
             JITDUMP("getStaticFieldContent returned false - bail out.");
@@ -1770,11 +1770,14 @@ GenTree* Compiler::impDuplicateWithProfiledArg(GenTreeCall* call, IL_OFFSET ilOf
             GenTree* profiledValueNode = gtNewIconNode(profiledValue, argClone->TypeGet());
             *argRef                    = profiledValueNode;
 
-            // TODO: Specify weights for the branches in the Qmark node.
             GenTreeColon* colon = new (this, GT_COLON) GenTreeColon(call->TypeGet(), call, fallbackCall);
             GenTreeOp*    cond  = gtNewOperNode(GT_EQ, TYP_INT, argClone, gtCloneExpr(profiledValueNode));
             GenTreeQmark* qmark = gtNewQmarkNode(call->TypeGet(), cond, colon);
 
+            // Weight the specialized path by how often the profiled value was seen, so that
+            // block layout keeps the unrolled call on the fall-through path.
+            qmark->SetThenNodeLikelihood(likelyValue.likelihood);
+
             JITDUMP("\n\nResulting tree:\n")
             DISPTREE(qmark)
 
@@ -1221,7 +1221,8 @@ void InlineStrategy::NoteOutcome(InlineContext* context)
 //     exceed the jit time budget for this method
 //
 // Arguments:
-//     ilSize - size of the method's IL
+//     ilSize        - size of the method's IL
+//     budgetPercent - percentage of the current budget the inline must fit in
 //
 // Return Value:
 //     true if the inline would go over budget
@@ -1229,15 +1230,18 @@ void InlineStrategy::NoteOutcome(InlineContext* context)
 // Notes:
 //     Presumes all IL in the method will be imported.
 
-bool InlineStrategy::BudgetCheck(unsigned ilSize)
+bool InlineStrategy::BudgetCheck(unsigned ilSize, unsigned budgetPercent)
 {
+    assert(budgetPercent <= 100);
+
     const int  timeDelta = EstimateInlineTime(ilSize);
-    const bool result    = (timeDelta + m_CurrentTimeEstimate > m_CurrentTimeBudget);
+    const int  budget    = (int)(((INT64)m_CurrentTimeBudget * budgetPercent) / 100);
+    const bool result    = (timeDelta + m_CurrentTimeEstimate > budget);
 
     if (result)
     {
-        JITDUMP("\nBudgetCheck: for IL Size %d, timeDelta %d +  currentEstimate %d > currentBudget %d\n", ilSize,
-                timeDelta, m_CurrentTimeEstimate, m_CurrentTimeBudget);
+        JITDUMP("\nBudgetCheck: for IL Size %d, timeDelta %d +  currentEstimate %d > currentBudget %d (%u%%)\n",
+                ilSize, timeDelta, m_CurrentTimeEstimate, m_CurrentTimeBudget, budgetPercent);
     }
 
     return result;
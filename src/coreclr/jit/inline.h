@@ -1022,8 +1022,8 @@ public:
     void DumpCsvData(FILE* f);
 
     // See if an inline of this size would fit within the current jit
-    // time budget.
-    bool BudgetCheck(unsigned ilSize);
+    // time budget, or the given percentage of it.
+    bool BudgetCheck(unsigned ilSize, unsigned budgetPercent = 100);
 
     // Check if inlining is disabled for the method being jitted
     bool IsInliningDisabled();
@@ -1467,6 +1467,54 @@ void ExtendedDefaultPolicy::NoteDouble(InlineObservation obs, double value)
     m_ProfileFrequency = value;
 }
 
+//------------------------------------------------------------------------
+// BudgetCheck: see if this inline would exceed the current budget
+//
+// Returns:
+//   True if inline would exceed the budget.
+//
+// Notes:
+//   The inliner visits candidates in IR order, so cold call sites met early can
+//   use up the budget that hot call sites deeper in the method would benefit
+//   from more. With trusted profile data, JitExtDefaultPolicyProfBudget reserves
+//   a percentage of the budget for call sites that run at least as often as the
+//   root method is entered.
+//
+bool ExtendedDefaultPolicy::BudgetCheck() const
+{
+    if (DefaultPolicy::BudgetCheck())
+    {
+        return true;
+    }
+
+    const unsigned reservePercent = min((unsigned)JitConfig.JitExtDefaultPolicyProfBudget(), 100u);
+
+    if (m_IsPrejitRoot || (reservePercent == 0) || !m_HasProfileWeights ||
+        !m_RootCompiler->fgHaveTrustedProfileWeights() || (m_ProfileFrequency >= 1.0))
+    {
+        return false;
+    }
+
+    // Like DefaultPolicy, never hold back forceinlines or tiny methods.
+    //
+    const unsigned skipBudgetChecksSize = 12;
+    if (m_IsForceInline || (m_CodeSize <= skipBudgetChecksSize))
+    {
+        return false;
+    }
+
+    InlineStrategy* strategy   = m_RootCompiler->m_inlineStrategy;
+    const bool      overBudget = strategy->BudgetCheck(EstimatedTotalILSize(), 100 - reservePercent);
+
+    if (overBudget)
+    {
+        JITDUMP("\nCallsite profile frequency %g, leaving the reserved budget to hotter call sites.",
+                m_ProfileFrequency);
+    }
+
+    return overBudget;
+}
+
 //------------------------------------------------------------------------
 // EstimatedTotalILSize: Estimate final IL size to import.
 //    ExtendedDefaultPolicy has a better understanding on how many branches
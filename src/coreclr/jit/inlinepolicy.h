@@ -236,6 +236,8 @@ public:
 
     unsigned EstimatedTotalILSize() const override;
 
+    bool BudgetCheck() const override;
+
     bool RequiresPreciseScan() override
     {
         return true;
@@ -369,6 +369,133 @@ void ObjectAllocator::ComputeStackObjectPointers(BitVecTraits* bitVecTraits)
     }
 }
 
+//------------------------------------------------------------------------
+// IsAllocationLocalToIteration: Check whether an object allocated in a block
+//                               that may be part of a loop is dead by the time
+//                               control can reach its allocation site again.
+//
+// Arguments:
+//    lclNum  - Local variable the allocation is stored to
+//    block   - Block containing the allocation
+//    stmt    - Statement containing the allocation
+//
+// Return Value:
+//    true if the allocation can reuse a single stack slot across iterations.
+//
+// Notes:
+//    Each time the allocation statement runs, the stack allocated instance is
+//    re-initialized in place, so no pointer to the previous instance may still
+//    be live. We check this conservatively: every local that may point at the
+//    object (per the connection graph) must be referenced only in this block,
+//    after the allocation, and must be fully defined before it is first used.
+//    Since the connection graph has no field edges, the object cannot be
+//    reached from anything other than those locals.
+
+bool ObjectAllocator::IsAllocationLocalToIteration(unsigned int lclNum, BasicBlock* block, Statement* stmt)
+{
+    class FindPointerLocalsVisitor final : public GenTreeVisitor<FindPointerLocalsVisitor>
+    {
+        ObjectAllocator* m_allocator;
+        BitVec&          m_pointers;
+        BitVec&          m_found;
+
+    public:
+        enum
+        {
+            DoPreOrder    = true,
+            DoLclVarsOnly = true,
+        };
+
+        FindPointerLocalsVisitor(ObjectAllocator* allocator, BitVec& pointers, BitVec& found)
+            : GenTreeVisitor<FindPointerLocalsVisitor>(allocator->comp)
+            , m_allocator(allocator)
+            , m_pointers(pointers)
+            , m_found(found)
+        {
+        }
+
+        Compiler::fgWalkResult PreOrderVisit(GenTree** use, GenTree* user)
+        {
+            unsigned const lclNum = (*use)->AsLclVarCommon()->GetLclNum();
+
+            // Locals created by earlier stack allocations are not tracked by the analysis.
+            //
+            BitVecTraits* const traits = &m_allocator->m_bitVecTraits;
+            if ((lclNum < BitVecTraits::GetSize(traits)) && BitVecOps::IsMember(traits, m_pointers, lclNum))
+            {
+                BitVecOps::AddElemD(traits, m_found, lclNum);
+            }
+
+            return Compiler::fgWalkResult::WALK_CONTINUE;
+        }
+    };
+
+    // Find all the locals that may point to the allocated object.
+    //
+    BitVec pointers = BitVecOps::MakeSingleton(&m_bitVecTraits, lclNum);
+    bool   changed  = true;
+
+    while (changed)
+    {
+        changed = false;
+        for (unsigned int i = 0; i < BitVecTraits::GetSize(&m_bitVecTraits); ++i)
+        {
+            if ((m_ConnGraphAdjacencyMatrix[i] != nullptr) && !BitVecOps::IsMember(&m_bitVecTraits, pointers, i) &&
+                !BitVecOps::IsEmptyIntersection(&m_bitVecTraits, pointers, m_ConnGraphAdjacencyMatrix[i]))
+            {
+                BitVecOps::AddElemD(&m_bitVecTraits, pointers, i);
+                changed = true;
+            }
+        }
+    }
+
+    BitVec defined = BitVecOps::MakeEmpty(&m_bitVecTraits);
+    BitVec found   = BitVecOps::MakeEmpty(&m_bitVecTraits);
+
+    for (BasicBlock* const b : comp->Blocks())
+    {
+        bool afterAlloc = false;
+
+        for (Statement* const s : b->Statements())
+        {
+            if (s == stmt)
+            {
+                assert(b == block);
+                BitVecOps::AddElemD(&m_bitVecTraits, defined, lclNum);
+                afterAlloc = true;
+                continue;
+            }
+
+            GenTree*       root   = s->GetRootNode();
+            unsigned const defNum = root->OperIs(GT_STORE_LCL_VAR) ? root->AsLclVar()->GetLclNum() : BAD_VAR_NUM;
+            const bool     isDef  = afterAlloc && (defNum < BitVecTraits::GetSize(&m_bitVecTraits)) &&
+                              BitVecOps::IsMember(&m_bitVecTraits, pointers, defNum);
+
+            BitVecOps::ClearD(&m_bitVecTraits, found);
+            FindPointerLocalsVisitor visitor(this, pointers, found);
+            visitor.WalkTree(isDef ? &root->AsLclVar()->Data() : s->GetRootNodePointer(), nullptr);
+
+            // Outside of the part of the block following the allocation, no pointer
+            // may be referenced at all; after it, only pointers defined earlier may be.
+            //
+            if ((!afterAlloc && !BitVecOps::IsEmpty(&m_bitVecTraits, found)) ||
+                !BitVecOps::IsSubset(&m_bitVecTraits, found, defined))
+            {
+                JITDUMP("V%02u may be live across iterations of " FMT_BB " via [%06u]\n", lclNum, block->bbNum,
+                        comp->dspTreeID(root));
+                return false;
+            }
+
+            if (isDef)
+            {
+                BitVecOps::AddElemD(&m_bitVecTraits, defined, defNum);
+            }
+        }
+    }
+
+    return true;
+}
+
 //------------------------------------------------------------------------
 // MorphAllocObjNodes: Morph each GT_ALLOCOBJ node either into an
 //                     allocation helper call or stack allocation.
@@ -442,23 +569,26 @@ bool ObjectAllocator::MorphAllocObjNodes()
                     comp->Metrics.NewRefClassHelperCalls++;
                 }
 
-                // Don't attempt to do stack allocations inside basic blocks that may be in a loop.
-                //
                 if (!IsObjectStackAllocationEnabled())
                 {
                     onHeapReason = "[object stack allocation disabled]";
                     canStack     = false;
                 }
-                else if (basicBlockHasBackwardJump)
-                {
-                    onHeapReason = "[alloc in loop]";
-                    canStack     = false;
-                }
                 else if (!CanAllocateLclVarOnStack(lclNum, clsHnd, &onHeapReason))
                 {
                     // reason set by the call
                     canStack = false;
                 }
+                // Inside basic blocks that may be in a loop, only allow stack allocations
+                // whose objects die before the next iteration reaches the allocation.
+                //
+                else if (basicBlockHasBackwardJump &&
+                         ((JitConfig.JitObjectStackAllocationInLoop() == 0) ||
+                          !IsAllocationLocalToIteration(lclNum, block, stmt)))
+                {
+                    onHeapReason = "[alloc in loop]";
+                    canStack     = false;
+                }
                 else if (stackClsHnd == NO_CLASS_HANDLE)
                 {
                     assert(isValueClass);
@@ -59,6 +59,7 @@ private:
     void         AddConnGraphEdge(unsigned int sourceLclNum, unsigned int targetLclNum);
     void         ComputeEscapingNodes(BitVecTraits* bitVecTraits, BitVec& escapingNodes);
     void         ComputeStackObjectPointers(BitVecTraits* bitVecTraits);
+    bool         IsAllocationLocalToIteration(unsigned int lclNum, BasicBlock* block, Statement* stmt);
     bool         MorphAllocObjNodes();
     void         RewriteUses();
     GenTree*     MorphAllocObjNodeIntoHelperCall(GenTreeAllocObj* allocObj);
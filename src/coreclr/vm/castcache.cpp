@@ -12,6 +12,7 @@
 BASEARRAYREF* CastCache::s_pTableRef = NULL;
 OBJECTHANDLE CastCache::s_sentinelTable = NULL;
 DWORD CastCache::s_lastFlushSize     = INITIAL_CACHE_SIZE;
+DWORD CastCache::s_maximumCacheSize  = MAXIMUM_CACHE_SIZE;
 const DWORD CastCache::INITIAL_CACHE_SIZE;
 
 BASEARRAYREF CastCache::CreateCastCache(DWORD size)
@@ -125,6 +126,15 @@ void CastCache::Initialize()
     }
     CONTRACTL_END;
 
+    // workloads that cast between thousands of distinct type pairs can raise the limit
+    // to avoid constant eviction. Larger tables cost more memory, but not slower lookups.
+    DWORD configuredMaximumSize = CLRConfig::GetConfigValue(CLRConfig::EXTERNAL_CastCacheMaxSize);
+    if (configuredMaximumSize != 0)
+    {
+        const DWORD LargestCacheSize = 1 << 20;
+        s_maximumCacheSize = RoundUpToPower2(min(max(configuredMaximumSize, INITIAL_CACHE_SIZE), LargestCacheSize));
+    }
+
     FieldDesc* pTableField = CoreLibBinder::GetField(FIELD__CASTCACHE__TABLE);
 
     GCX_COOP();
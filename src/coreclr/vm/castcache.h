@@ -206,6 +206,9 @@ private:
 
     static DWORD          s_lastFlushSize;
 
+    // the size the table is allowed to grow to, MAXIMUM_CACHE_SIZE unless configured otherwise
+    static DWORD          s_maximumCacheSize;
+
     FORCEINLINE static TypeHandle::CastResult TryGetFromCache(TADDR source, TADDR target)
     {
         CONTRACTL
@@ -251,7 +254,7 @@ private:
         CONTRACTL_END;
 
         DWORD newSize = CacheElementCount(tableData) * 2;
-        if (newSize <= MAXIMUM_CACHE_SIZE)
+        if (newSize <= s_maximumCacheSize)
         {
             return MaybeReplaceCacheWithLarger(newSize);
         }
@@ -1596,15 +1596,17 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
                 return result;
             }
 
+            // The remaining spin is bounded by the lock's adaptive spin count
+            const DWORD lockSpinCount = awareLock->GetSpinCount();
             ++spinIteration;
-            if (spinIteration < spinCount)
+            if (spinIteration < lockSpinCount)
             {
                 while (true)
                 {
                     AwareLock::SpinWait(normalizationInfo, spinIteration);
 
                     ++spinIteration;
-                    if (spinIteration >= spinCount)
+                    if (spinIteration >= lockSpinCount)
                     {
                         // The last lock attempt for this spin will be done after the loop
                         break;
@@ -1613,6 +1615,7 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
                     result = awareLock->TryEnterInsideSpinLoopHelper(pCurThread);
                     if (result == AwareLock::EnterHelperResult_Entered)
                     {
+                        awareLock->RecordSpinResult(true /* acquiredLock */);
                         return AwareLock::EnterHelperResult_Entered;
                     }
                     if (result == AwareLock::EnterHelperResult_UseSlowPath)
@@ -1622,7 +1625,9 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
                 }
             }
 
-            if (awareLock->TryEnterAfterSpinLoopHelper(pCurThread))
+            bool acquiredLock = awareLock->TryEnterAfterSpinLoopHelper(pCurThread);
+            awareLock->RecordSpinResult(acquiredLock);
+            if (acquiredLock)
             {
                 return AwareLock::EnterHelperResult_Entered;
             }
@@ -2651,7 +2656,9 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
             {
                 bool acquiredLock = false;
                 YieldProcessorNormalizationInfo normalizationInfo;
-                const DWORD spinCount = g_SpinConstants.dwMonitorSpinCount;
+
+                // The spin is bounded by the lock's adaptive spin count, and its result feeds back into that count
+                const DWORD spinCount = GetSpinCount();
                 for (DWORD spinIteration = 0; spinIteration < spinCount; ++spinIteration)
                 {
                     if (m_lockState.InterlockedTry_LockAndUnregisterWaiterAndObserveWakeSignal(this))
@@ -2662,6 +2669,10 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
 
                     SpinWait(normalizationInfo, spinIteration);
                 }
+                if (spinCount != 0)
+                {
+                    RecordSpinResult(acquiredLock);
+                }
                 if (acquiredLock)
                 {
                     break;
@@ -451,7 +451,12 @@ private:
     DWORD m_waiterStarvationStartTimeMs;
     int m_emittedLockCreatedEvent;
 
+    // Number of spin iterations a contending thread performs on this lock before waiting. Adjusted based on whether recent
+    // spins acquired the lock, see RecordSpinResult(). Updates are not synchronized, it is only a heuristic.
+    DWORD m_spinCount;
+
     static const DWORD WaiterStarvationDurationMsBeforeStoppingPreemptingWaiters = 100;
+    static const DWORD MinimumSpinCount = 1;
 
     // Only SyncBlocks can create AwareLocks.  Hence this private constructor.
     AwareLock(DWORD indx)
@@ -465,7 +470,8 @@ private:
           m_TransientPrecious(0),
           m_dwSyncIndex(indx),
           m_waiterStarvationStartTimeMs(0),
-          m_emittedLockCreatedEvent(0)
+          m_emittedLockCreatedEvent(0),
+          m_spinCount(g_SpinConstants.dwMonitorSpinCount)
     {
         LIMITED_METHOD_CONTRACT;
     }
@@ -551,6 +557,11 @@ private: // friend access is required for this unsafe function
 public:
     static void SpinWait(const YieldProcessorNormalizationInfo &normalizationInfo, DWORD spinIteration);
 
+    // Adaptive spin count for contending threads. Spinning that acquires the lock lets later contenders spin longer, and
+    // spinning that ends up waiting anyway shortens it, bounded by g_SpinConstants.dwMonitorSpinCount.
+    DWORD GetSpinCount() const;
+    void RecordSpinResult(bool acquiredLock);
+
     // Helper encapsulating the fast path entering monitor. Returns what kind of result was achieved.
     bool TryEnterHelper(Thread* pCurThread);
 
@@ -468,6 +468,42 @@ FORCEINLINE void AwareLock::SpinWait(const YieldProcessorNormalizationInfo &norm
     YieldProcessorWithBackOffNormalized(normalizationInfo, spinIteration);
 }
 
+FORCEINLINE DWORD AwareLock::GetSpinCount() const
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD spinCount = VolatileLoadWithoutBarrier(&m_spinCount);
+    _ASSERTE(spinCount <= g_SpinConstants.dwMonitorSpinCount);
+    return spinCount;
+}
+
+FORCEINLINE void AwareLock::RecordSpinResult(bool acquiredLock)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // Grow slowly on success and shrink faster on failure. Iterations late in the spin are the most expensive due to the
+    // exponential back-off, so trimming them first is where most of the wasted CPU time is saved. The count never drops
+    // below MinimumSpinCount so that a lock whose hold time becomes short again can recover.
+    DWORD spinCount = VolatileLoadWithoutBarrier(&m_spinCount);
+    DWORD newSpinCount;
+    if (acquiredLock)
+    {
+        newSpinCount = min(spinCount + 1, g_SpinConstants.dwMonitorSpinCount);
+    }
+    else
+    {
+        newSpinCount = spinCount > MinimumSpinCount + 1 ? spinCount - 2 : min(MinimumSpinCount, spinCount);
+    }
+
+    _ASSERTE(newSpinCount <= g_SpinConstants.dwMonitorSpinCount);
+    _ASSERTE(newSpinCount >= min(MinimumSpinCount, g_SpinConstants.dwMonitorSpinCount));
+
+    if (newSpinCount != spinCount)
+    {
+        VolatileStoreWithoutBarrier(&m_spinCount, newSpinCount);
+    }
+}
+
 FORCEINLINE bool AwareLock::TryEnterHelper(Thread* pCurThread)
 {
     CONTRACTL{
@@ -19,7 +19,7 @@
 #include <mono/utils/mono-error.h>
 #include "mono/utils/mono-conc-hashtable.h"
 #include "mono/utils/refcount.h"
-// for dn_simdhash_string_ptr_t and dn_simdhash_u32_ptr_t
+// for dn_simdhash_string_ptr_t, dn_simdhash_u32_ptr_t and dn_simdhash_ptr_ptr_t
 #include "../native/containers/dn-simdhash-specializations.h"
 
 struct _MonoType {
@@ -432,10 +432,10 @@ struct _MonoImage {
 	/* indexed by typespec tokens. */
 	MonoConcurrentHashTable *typespec_cache; /* protected by the image lock */
 	/* indexed by token */
-	GHashTable *memberref_signatures;
+	dn_simdhash_u32_ptr_t *memberref_signatures; /*protected by the image lock*/
 
 	/* Indexed by blob heap indexes */
-	GHashTable *method_signatures;
+	dn_simdhash_ptr_ptr_t *method_signatures; /*protected by the image lock*/
 
 	/*
 	 * Indexes namespaces to hash tables that map class name to typedef token.
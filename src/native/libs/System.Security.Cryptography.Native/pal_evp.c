@@ -10,31 +10,62 @@
 
 #define SUCCESS 1
 
-static const EVP_MD* g_evpFetchMd5 = NULL;
-static pthread_once_t g_evpFetch = PTHREAD_ONCE_INIT;
-
-static void EnsureFetchEvpMdAlgorithms(void)
-{
-    // This is called from a pthread_once - this method should not be called directly.
-
+// Under OpenSSL 3 the implicit EVP_sha256()-style getters go through the provider's property query machinery, which
+// takes global locks, every time a context is initialized with them. Each digest is fetched once and the resulting
+// EVP_MD is reused for the lifetime of the process. The getters remain the fallback if fetching is unavailable or fails.
 #ifdef NEED_OPENSSL_3_0
-    if (API_EXISTS(EVP_MD_fetch))
-    {
-        ERR_clear_error();
-
-        // Try to fetch an MD5 implementation that will work regardless if
-        // FIPS is enforced or not.
-        g_evpFetchMd5 = EVP_MD_fetch(NULL, "MD5", "-fips");
+#define FETCH_EVP_MD(target, name, query) \
+    if (API_EXISTS(EVP_MD_fetch)) \
+    { \
+        ERR_clear_error(); \
+        target = EVP_MD_fetch(NULL, name, query); \
+        if (target == NULL) \
+        { \
+            ERR_clear_error(); \
+        } \
     }
+#else
+#define FETCH_EVP_MD(target, name, query)
 #endif
 
-    // No error queue impact.
-    // If EVP_MD_fetch is unavailable, use the implicit loader. If it failed, use the implicit loader as a last resort.
-    if (g_evpFetchMd5 == NULL)
-    {
-        g_evpFetchMd5 = EVP_md5();
-    }
+#define BUILD_MD_FETCH(export, fn, name, query) \
+static const EVP_MD* g_evpFetch##export = NULL; \
+static pthread_once_t g_evpFetchInit##export = PTHREAD_ONCE_INIT; \
+static void EnsureFetch##export(void) \
+{ \
+    /* This is called from a pthread_once - this method should not be called directly. */ \
+    FETCH_EVP_MD(g_evpFetch##export, name, query) \
+    /* No error queue impact. */ \
+    if (g_evpFetch##export == NULL) \
+    { \
+        g_evpFetch##export = fn(); \
+    } \
+} \
+const EVP_MD* export(void) \
+{ \
+    pthread_once(&g_evpFetchInit##export, EnsureFetch##export); \
+    return g_evpFetch##export; \
+}
+
+#if HAVE_OPENSSL_SHA3
+#define BUILD_IMPLICIT_SHA3(fn) \
+static const EVP_MD* fn##_implicit(void) \
+{ \
+    return API_EXISTS(fn) ? fn() : NULL; \
+}
+#else
+#define BUILD_IMPLICIT_SHA3(fn) \
+static const EVP_MD* fn##_implicit(void) \
+{ \
+    return NULL; \
 }
+#endif
+
+BUILD_IMPLICIT_SHA3(EVP_sha3_256)
+BUILD_IMPLICIT_SHA3(EVP_sha3_384)
+BUILD_IMPLICIT_SHA3(EVP_sha3_512)
+BUILD_IMPLICIT_SHA3(EVP_shake128)
+BUILD_IMPLICIT_SHA3(EVP_shake256)
 
 EVP_MD_CTX* CryptoNative_EvpMdCtxCreate(const EVP_MD* type)
 {
@@ -291,100 +322,17 @@ int32_t CryptoNative_EvpMdSize(const EVP_MD* md)
     return EVP_MD_get_size(md);
 }
 
-const EVP_MD* CryptoNative_EvpMd5(void)
-{
-    pthread_once(&g_evpFetch, EnsureFetchEvpMdAlgorithms);
-    return g_evpFetchMd5;
-}
-
-const EVP_MD* CryptoNative_EvpSha1(void)
-{
-    // No error queue impact.
-    return EVP_sha1();
-}
-
-const EVP_MD* CryptoNative_EvpSha256(void)
-{
-    // No error queue impact.
-    return EVP_sha256();
-}
-
-const EVP_MD* CryptoNative_EvpSha384(void)
-{
-    // No error queue impact.
-    return EVP_sha384();
-}
-
-const EVP_MD* CryptoNative_EvpSha512(void)
-{
-    // No error queue impact.
-    return EVP_sha512();
-}
-
-const EVP_MD* CryptoNative_EvpSha3_256(void)
-{
-    // No error queue impact.
-#if HAVE_OPENSSL_SHA3
-    if (API_EXISTS(EVP_sha3_256))
-    {
-        return EVP_sha3_256();
-    }
-#endif
-
-    return NULL;
-}
-
-const EVP_MD* CryptoNative_EvpSha3_384(void)
-{
-    // No error queue impact.
-#if HAVE_OPENSSL_SHA3
-    if (API_EXISTS(EVP_sha3_384))
-    {
-        return EVP_sha3_384();
-    }
-#endif
-
-    return NULL;
-}
-
-const EVP_MD* CryptoNative_EvpSha3_512(void)
-{
-    // No error queue impact.
-#if HAVE_OPENSSL_SHA3
-    if (API_EXISTS(EVP_sha3_512))
-    {
-        return EVP_sha3_512();
-    }
-#endif
-
-    return NULL;
-}
-
-const EVP_MD* CryptoNative_EvpShake128(void)
-{
-    // No error queue impact.
-#if HAVE_OPENSSL_SHA3
-    if (API_EXISTS(EVP_shake128))
-    {
-        return EVP_shake128();
-    }
-#endif
-
-    return NULL;
-}
-
-const EVP_MD* CryptoNative_EvpShake256(void)
-{
-    // No error queue impact.
-#if HAVE_OPENSSL_SHA3
-    if (API_EXISTS(EVP_shake256))
-    {
-        return EVP_shake256();
-    }
-#endif
-
-    return NULL;
-}
+// Fetch an MD5 implementation that will work regardless if FIPS is enforced or not.
+BUILD_MD_FETCH(CryptoNative_EvpMd5, EVP_md5, "MD5", "-fips")
+BUILD_MD_FETCH(CryptoNative_EvpSha1, EVP_sha1, "SHA1", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha256, EVP_sha256, "SHA256", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha384, EVP_sha384, "SHA384", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha512, EVP_sha512, "SHA512", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha3_256, EVP_sha3_256_implicit, "SHA3-256", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha3_384, EVP_sha3_384_implicit, "SHA3-384", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpSha3_512, EVP_sha3_512_implicit, "SHA3-512", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpShake128, EVP_shake128_implicit, "SHAKE-128", NULL)
+BUILD_MD_FETCH(CryptoNative_EvpShake256, EVP_shake256_implicit, "SHAKE-256", NULL)
 
 int32_t CryptoNative_GetMaxMdSize(void)
 {
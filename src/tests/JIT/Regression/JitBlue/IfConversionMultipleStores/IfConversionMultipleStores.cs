@@ -0,0 +1,131 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+// If conversion of half diamonds whose Then case has several local stores.
+
+using System;
+using System.Runtime.CompilerServices;
+using Xunit;
+
+public class IfConversionMultipleStores
+{
+    static readonly int[] s_values = { 0, 1, -1, 5, 5, 42, -42, int.MaxValue, int.MinValue, 7, 3, 3 };
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int TwoStores(int a, int b)
+    {
+        int lo = b;
+        int hi = a;
+        if (a < b)
+        {
+            lo = a;
+            hi = b;
+        }
+        return Combine(lo, hi, 0);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ThreeStores(int a, int b, int c)
+    {
+        int x = 1;
+        int y = 2;
+        int z = 3;
+        if (a > b)
+        {
+            x = a;
+            y = b;
+            z = c;
+        }
+        return Combine(x, y, z);
+    }
+
+    // 'a' is both stored to and read by the condition. Re-evaluating the condition
+    // for the second store would see the new value, so this must not be converted.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int StoreToConditionOperand(int a, int b)
+    {
+        int c = 0;
+        if (a < b)
+        {
+            a = b;
+            c = 1;
+        }
+        return Combine(a, c, 0);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int StoresInLoop(int[] values)
+    {
+        int result = 0;
+        for (int i = 1; i < values.Length; i++)
+        {
+            int a = values[i - 1];
+            int b = values[i];
+            int lo = b;
+            int hi = a;
+            if (a < b)
+            {
+                lo = a;
+                hi = b;
+            }
+            result = unchecked(result * 31 + Combine(lo, hi, 0));
+        }
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Combine(int x, int y, int z) => unchecked(x * 961 + y * 31 + z);
+
+    static int StoresInLoopExpected(int[] values)
+    {
+        int result = 0;
+        for (int i = 1; i < values.Length; i++)
+        {
+            int a = values[i - 1];
+            int b = values[i];
+            result = unchecked(result * 31 + Combine(Math.Min(a, b), Math.Max(a, b), 0));
+        }
+        return result;
+    }
+
+    [Fact]
+    public static int TestEntryPoint()
+    {
+        int result = 100;
+
+        foreach (int a in s_values)
+        {
+            foreach (int b in s_values)
+            {
+                if (TwoStores(a, b) != Combine(Math.Min(a, b), Math.Max(a, b), 0))
+                {
+                    Console.WriteLine($"TwoStores({a}, {b}) failed");
+                    result = 101;
+                }
+
+                if (StoreToConditionOperand(a, b) != ((a < b) ? Combine(b, 1, 0) : Combine(a, 0, 0)))
+                {
+                    Console.WriteLine($"StoreToConditionOperand({a}, {b}) failed");
+                    result = 103;
+                }
+
+                foreach (int c in s_values)
+                {
+                    if (ThreeStores(a, b, c) != ((a > b) ? Combine(a, b, c) : Combine(1, 2, 3)))
+                    {
+                        Console.WriteLine($"ThreeStores({a}, {b}, {c}) failed");
+                        result = 102;
+                    }
+                }
+            }
+        }
+
+        if (StoresInLoop(s_values) != StoresInLoopExpected(s_values))
+        {
+            Console.WriteLine("StoresInLoop failed");
+            result = 104;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,164 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+// Allocations inside loops may only be stack allocated when the object is dead
+// before the allocation runs again, since each iteration reuses the same slot.
+
+using System;
+using System.Runtime.CompilerServices;
+using Xunit;
+
+public class ObjectStackAllocationInLoop
+{
+    sealed class Box
+    {
+        public int Value;
+
+        public Box(int value)
+        {
+            Value = value;
+        }
+    }
+
+    // Each object dies within its iteration, so this may be stack allocated.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int PerIteration(int n)
+    {
+        int sum = 0;
+        for (int i = 0; i < n; i++)
+        {
+            Box b = new Box(i);
+            sum += b.Value;
+        }
+        return sum;
+    }
+
+    // The previous iteration's object is still read after the next one is allocated.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int LoopCarried(int n)
+    {
+        int sum = 0;
+        Box prev = null;
+        for (int i = 1; i <= n; i++)
+        {
+            Box b = new Box(i);
+            if (prev != null)
+            {
+                sum += prev.Value * 10 + b.Value;
+            }
+            prev = b;
+        }
+        return sum;
+    }
+
+    // The object only flows to its use through a phi at the loop head.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int BackEdge(int n)
+    {
+        int sum = 0;
+        Box b = null;
+        for (int i = 0; i < n; i++)
+        {
+            if (b != null)
+            {
+                sum += b.Value;
+            }
+            b = new Box(i + 1);
+        }
+        return sum + ((b != null) ? b.Value * 1000 : 0);
+    }
+
+    // The object is conditionally replaced, so the live instance can come
+    // from any earlier iteration.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ConditionalPhi(int n)
+    {
+        int sum = 0;
+        Box keep = new Box(-1);
+        for (int i = 0; i < n; i++)
+        {
+            Box b = new Box(i);
+            if ((i % 3) == 0)
+            {
+                keep = b;
+            }
+            sum += keep.Value;
+        }
+        return sum;
+    }
+
+    static int LoopCarriedExpected(int n)
+    {
+        int sum = 0;
+        for (int i = 2; i <= n; i++)
+        {
+            sum += (i - 1) * 10 + i;
+        }
+        return sum;
+    }
+
+    static int ConditionalPhiExpected(int n)
+    {
+        int sum = 0;
+        int keep = -1;
+        for (int i = 0; i < n; i++)
+        {
+            if ((i % 3) == 0)
+            {
+                keep = i;
+            }
+            sum += keep;
+        }
+        return sum;
+    }
+
+    // Runs the test once so that it is jitted, then returns the bytes allocated by a second run.
+    static long AllocatedBytes(Func<int, int> test, int n, out int value)
+    {
+        test(n);
+
+        long before = GC.GetAllocatedBytesForCurrentThread();
+        value = test(n);
+        return GC.GetAllocatedBytesForCurrentThread() - before;
+    }
+
+    [Fact]
+    public static int TestEntryPoint()
+    {
+        const int n = 10;
+        int result = 100;
+        int value;
+
+        // Only this allocation is dead by the next iteration, so it is the only one
+        // that may be stack allocated.
+        long allocated = AllocatedBytes(PerIteration, n, out value);
+        if ((value != (n * (n - 1)) / 2) || (allocated != 0))
+        {
+            Console.WriteLine($"PerIteration failed: {value}, allocated {allocated} bytes");
+            result = 101;
+        }
+
+        allocated = AllocatedBytes(LoopCarried, n, out value);
+        if ((value != LoopCarriedExpected(n)) || (allocated == 0))
+        {
+            Console.WriteLine($"LoopCarried failed: {value}, allocated {allocated} bytes");
+            result = 102;
+        }
+
+        allocated = AllocatedBytes(BackEdge, n, out value);
+        if ((value != ((n * (n - 1)) / 2 + n * 1000)) || (allocated == 0))
+        {
+            Console.WriteLine($"BackEdge failed: {value}, allocated {allocated} bytes");
+            result = 103;
+        }
+
+        allocated = AllocatedBytes(ConditionalPhi, n, out value);
+        if ((value != ConditionalPhiExpected(n)) || (allocated == 0))
+        {
+            Console.WriteLine($"ConditionalPhi failed: {value}, allocated {allocated} bytes");
+            result = 104;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,261 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+// Static readonly structs with a few primitive fields are folded field by field.
+// Structs whose data is not fully described by their declared fields (inline
+// arrays and fixed buffers) must not be.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+using Xunit;
+
+public unsafe class StaticReadonlyIndexableStruct
+{
+    [InlineArray(4)]
+    struct IntArray4
+    {
+        public int Element;
+    }
+
+    [InlineArray(3)]
+    struct ByteArray3
+    {
+        public byte Element;
+    }
+
+    struct FixedBuffer
+    {
+        public int Length;
+        public fixed byte Data[6];
+    }
+
+    struct FixedBufferOnly
+    {
+        public fixed short Data[4];
+    }
+
+    static readonly IntArray4 s_ints = CreateInts();
+    static readonly ByteArray3 s_bytes = CreateBytes();
+    static readonly FixedBuffer s_fixed = CreateFixed();
+    static readonly FixedBufferOnly s_fixedOnly = CreateFixedOnly();
+
+    struct IntDouble
+    {
+        public int I;
+        public double D;
+    }
+
+    struct BoolFloatInt
+    {
+        public bool B;
+        public float F;
+        public int I;
+    }
+
+    struct Mixed4
+    {
+        public byte B;
+        public long L;
+        public float F;
+        public bool Z;
+    }
+
+    struct IntInt
+    {
+        public int X;
+        public int Y;
+    }
+
+    static readonly IntDouble s_intDouble = new IntDouble { I = -7, D = 2.5 };
+    static readonly BoolFloatInt s_boolFloatInt = new BoolFloatInt { B = true, F = -1.25f, I = 123456 };
+    static readonly Mixed4 s_mixed4 = new Mixed4 { B = 200, L = 0x123456789AL, F = 0.5f, Z = true };
+    static readonly Mixed4 s_mixed4PartlyZero = new Mixed4 { B = 0, L = -1, F = 0.0f, Z = true };
+    static readonly IntInt s_intInt = new IntInt { X = 3, Y = -4 };
+
+    static IntArray4 CreateInts()
+    {
+        IntArray4 a = default;
+        a[0] = 0;
+        a[1] = 11;
+        a[2] = 22;
+        a[3] = 33;
+        return a;
+    }
+
+    static ByteArray3 CreateBytes()
+    {
+        ByteArray3 a = default;
+        a[0] = 1;
+        a[1] = 2;
+        a[2] = 3;
+        return a;
+    }
+
+    static FixedBuffer CreateFixed()
+    {
+        FixedBuffer f = default;
+        f.Length = 6;
+        for (int i = 0; i < 6; i++)
+        {
+            f.Data[i] = (byte)(i + 1);
+        }
+        return f;
+    }
+
+    static FixedBufferOnly CreateFixedOnly()
+    {
+        FixedBufferOnly f = default;
+        for (int i = 0; i < 4; i++)
+        {
+            f.Data[i] = (short)((i + 1) * 100);
+        }
+        return f;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int SumInts()
+    {
+        IntArray4 a = s_ints;
+        return a[0] + a[1] + a[2] + a[3];
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int SumBytes()
+    {
+        ByteArray3 a = s_bytes;
+        return a[0] + a[1] + a[2];
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int SumFixed()
+    {
+        FixedBuffer f = s_fixed;
+        int sum = f.Length * 100;
+        for (int i = 0; i < 6; i++)
+        {
+            sum += f.Data[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int SumFixedOnly()
+    {
+        FixedBufferOnly f = s_fixedOnly;
+        return f.Data[0] + f.Data[1] + f.Data[2] + f.Data[3];
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool CheckIntDouble()
+    {
+        IntDouble v = s_intDouble;
+        return (v.I == -7) && (v.D == 2.5);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool CheckBoolFloatInt()
+    {
+        BoolFloatInt v = s_boolFloatInt;
+        return v.B && (v.F == -1.25f) && (v.I == 123456);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool CheckMixed4()
+    {
+        Mixed4 v = s_mixed4;
+        return (v.B == 200) && (v.L == 0x123456789AL) && (v.F == 0.5f) && v.Z;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool CheckMixed4PartlyZero()
+    {
+        Mixed4 v = s_mixed4PartlyZero;
+        return (v.B == 0) && (v.L == -1) && (v.F == 0.0f) && v.Z;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool CheckIntInt()
+    {
+        IntInt v = s_intInt;
+        return (v.X == 3) && (v.Y == -4);
+    }
+
+    [Fact]
+    public static int TestEntryPoint()
+    {
+        int result = 100;
+
+        // Make sure the class constructor has run, so that the methods are
+        // rejitted at Tier1 with the static values available as constants.
+        for (int i = 0; i < 200; i++)
+        {
+            SumInts();
+            SumBytes();
+            SumFixed();
+            SumFixedOnly();
+            CheckIntDouble();
+            CheckBoolFloatInt();
+            CheckMixed4();
+            CheckMixed4PartlyZero();
+            CheckIntInt();
+            Thread.Sleep(1);
+        }
+
+        if (SumInts() != 66)
+        {
+            Console.WriteLine("SumInts failed");
+            result = 101;
+        }
+
+        if (SumBytes() != 6)
+        {
+            Console.WriteLine("SumBytes failed");
+            result = 102;
+        }
+
+        if (SumFixed() != 621)
+        {
+            Console.WriteLine("SumFixed failed");
+            result = 103;
+        }
+
+        if (SumFixedOnly() != 1000)
+        {
+            Console.WriteLine("SumFixedOnly failed");
+            result = 104;
+        }
+
+        if (!CheckIntDouble())
+        {
+            Console.WriteLine("CheckIntDouble failed");
+            result = 105;
+        }
+
+        if (!CheckBoolFloatInt())
+        {
+            Console.WriteLine("CheckBoolFloatInt failed");
+            result = 106;
+        }
+
+        if (!CheckMixed4())
+        {
+            Console.WriteLine("CheckMixed4 failed");
+            result = 107;
+        }
+
+        if (!CheckMixed4PartlyZero())
+        {
+            Console.WriteLine("CheckMixed4PartlyZero failed");
+            result = 108;
+        }
+
+        if (!CheckIntInt())
+        {
+            Console.WriteLine("CheckIntInt failed");
+            result = 109;
+        }
+
+        return result;
+    }
+}
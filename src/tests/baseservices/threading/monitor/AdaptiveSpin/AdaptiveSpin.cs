@@ -0,0 +1,84 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+
+// Each contended monitor keeps its own spin count, which shrinks while spinning
+// keeps failing (long hold times) and grows back once spinning pays off again.
+// The count isn't observable from managed code, so this drives one lock through
+// short, long and short hold phases, which makes both the spinners and the woken
+// waiters grow, shrink and recover the count. It checks that the lock stays
+// correct and that every thread makes progress in each phase. Checked runtimes
+// also validate the count's bounds each time it is updated.
+
+using System;
+using System.Threading;
+using Xunit;
+
+public class AdaptiveSpin
+{
+    static readonly object s_lock = new object();
+    static long s_counter;
+    static int s_inside;
+    static bool s_failed;
+
+    static void RunPhase(string name, int threadCount, int iterations, Action holdLock)
+    {
+        long expected = s_counter + (long)threadCount * iterations;
+        Thread[] threads = new Thread[threadCount];
+
+        for (int t = 0; t < threadCount; t++)
+        {
+            threads[t] = new Thread(() =>
+            {
+                for (int i = 0; i < iterations; i++)
+                {
+                    lock (s_lock)
+                    {
+                        if (Interlocked.Increment(ref s_inside) != 1)
+                        {
+                            s_failed = true;
+                        }
+
+                        s_counter++;
+                        holdLock();
+
+                        Interlocked.Decrement(ref s_inside);
+                    }
+                }
+            });
+            threads[t].Start();
+        }
+
+        foreach (Thread thread in threads)
+        {
+            if (!thread.Join(TimeSpan.FromMinutes(2)))
+            {
+                Console.WriteLine($"{name}: a thread made no progress");
+                s_failed = true;
+                return;
+            }
+        }
+
+        if (s_counter != expected)
+        {
+            Console.WriteLine($"{name}: expected {expected}, got {s_counter}");
+            s_failed = true;
+        }
+    }
+
+    [Fact]
+    public static int TestEntryPoint()
+    {
+        int threadCount = Math.Max(4, Math.Min(Environment.ProcessorCount * 2, 16));
+
+        // Short hold times, spinning acquires the lock
+        RunPhase("short", threadCount, 20000, () => { });
+
+        // Long hold times, spinning gives up and threads wait
+        RunPhase("long", threadCount, 20, () => Thread.Sleep(1));
+
+        // Short hold times again, the spin count recovers
+        RunPhase("recover", threadCount, 20000, () => { });
+
+        return s_failed ? 101 : 100;
+    }
+}